@@ -0,0 +1,336 @@
+// Micro-benchmarks for the core data structures over synthetic catalogs.
+// Run through `make bench`, which writes machine-readable results to bench/results.json.
+#include "job_json.h"
+#include "job_portal.h"
+#include "json_writer.h"
+#include "sharded_search.h"
+#include "wire_format.h"
+#include "workload.h"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <memory>
+
+namespace {
+
+// One catalog at a time is kept alive; the 1M-job catalog alone is several hundred MB
+const std::vector<Job>& catalog(size_t n) {
+    static size_t cachedSize = 0;
+    static std::unique_ptr<std::vector<Job>> cached;
+    if (cachedSize != n) {
+        cached.reset();
+        cached = std::make_unique<std::vector<Job>>(generateJobs(n));
+        cachedSize = n;
+    }
+    return *cached;
+}
+
+void catalogSizes(benchmark::internal::Benchmark* b) {
+    for (int n : {10000, 100000, 1000000}) b->Arg(n);
+    b->Unit(benchmark::kMillisecond);
+}
+
+void BM_TrieInsert(benchmark::State& state) {
+    const auto& jobs = catalog(state.range(0));
+    for (auto _ : state) {
+        Trie trie;
+        for (const auto& job : jobs) trie.insert(job.title);
+        benchmark::DoNotOptimize(trie.nodeCount());
+    }
+    state.SetItemsProcessed(state.iterations() * jobs.size());
+}
+BENCHMARK(BM_TrieInsert)->Apply(catalogSizes);
+
+void BM_TrieSearchPrefix(benchmark::State& state) {
+    const auto& jobs = catalog(state.range(0));
+    Trie trie;
+    for (const auto& job : jobs) trie.insert(job.title);
+    const char* prefixes[] = {"S", "Se", "Senior D", "Lead Q", "Principal Data"};
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(trie.searchPrefix(prefixes[i++ % 5]));
+    }
+}
+BENCHMARK(BM_TrieSearchPrefix)->Apply(catalogSizes)->Unit(benchmark::kMicrosecond);
+
+void BM_TrieSearchFuzzy(benchmark::State& state) {
+    const auto& jobs = catalog(state.range(0));
+    Trie termTrie;
+    for (const auto& job : jobs) {
+        for (const auto& term : jobTerms(job)) termTrie.insert(term);
+    }
+    const char* typos[] = {"javscript", "kuberentes", "pyhton", "enginer", "analsyt"};
+    size_t i = 0;
+    for (auto _ : state) {
+        const char* typo = typos[i++ % 5];
+        benchmark::DoNotOptimize(termTrie.searchFuzzy(typo, fuzzyEditBudget(typo)));
+    }
+}
+BENCHMARK(BM_TrieSearchFuzzy)->Apply(catalogSizes)->Unit(benchmark::kMicrosecond);
+
+void BM_RelevanceScoreScan(benchmark::State& state) {
+    const auto& jobs = catalog(state.range(0));
+    for (auto _ : state) {
+        long total = 0;
+        for (const auto& job : jobs) total += relevanceScore(job, "script");
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * jobs.size());
+}
+BENCHMARK(BM_RelevanceScoreScan)->Apply(catalogSizes);
+
+void BM_ToLower(benchmark::State& state) {
+    std::string title = "Principal Machine Learning Engineer (TensorFlow, PyTorch)";
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(toLower(title));
+    }
+    state.SetBytesProcessed(state.iterations() * title.size());
+}
+BENCHMARK(BM_ToLower);
+
+void BM_Split(benchmark::State& state) {
+    std::string line = "JavaScript, React , Node.js,SQL,  AWS, Docker, Kubernetes";
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(split(line, ','));
+    }
+    state.SetBytesProcessed(state.iterations() * line.size());
+}
+BENCHMARK(BM_Split);
+
+void BM_SkillIndexUpdate(benchmark::State& state) {
+    const auto& jobs = catalog(state.range(0));
+    for (auto _ : state) {
+        InvertedIndex skillIndex;
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            for (const auto& skill : jobs[i].skills) skillIndex[toLower(skill)].push_back(i);
+        }
+        benchmark::DoNotOptimize(skillIndex.size());
+    }
+    state.SetItemsProcessed(state.iterations() * jobs.size());
+}
+BENCHMARK(BM_SkillIndexUpdate)->Apply(catalogSizes);
+
+void BM_ShardedSearchIngest(benchmark::State& state) {
+    const auto& jobs = catalog(state.range(0));
+    for (auto _ : state) {
+        ShardedSearch shards(1);
+        for (size_t i = 0; i < jobs.size(); ++i) shards.addJob(i, jobs[i]);
+        benchmark::DoNotOptimize(shards.trigramCount());
+    }
+    state.SetItemsProcessed(state.iterations() * jobs.size());
+}
+BENCHMARK(BM_ShardedSearchIngest)->Apply(catalogSizes);
+
+void BM_ShardedSearchQuery(benchmark::State& state) {
+    const auto& jobs = catalog(state.range(0));
+    ShardedSearch shards(std::max(1u, std::thread::hardware_concurrency()));
+    for (size_t i = 0; i < jobs.size(); ++i) shards.addJob(i, jobs[i]);
+    const std::string queries[] = {"script", "data analyst", "kubernetes", "go", "principal cloud"};
+    size_t i = 0;
+    for (auto _ : state) {
+        const std::string& query = queries[i++ % 5];
+        auto result = shards.search(jobs, {query}, 10, [&](const Job& job) { return relevanceScore(job, query); }, false);
+        benchmark::DoNotOptimize(result.top.data());
+    }
+}
+BENCHMARK(BM_ShardedSearchQuery)->Apply(catalogSizes);
+
+void BM_JobToJson(benchmark::State& state) {
+    const auto& jobs = catalog(state.range(0));
+    for (auto _ : state) {
+        nlohmann::json response;
+        response["jobs"] = nlohmann::json::array();
+        for (size_t i = 0; i < jobs.size(); ++i) response["jobs"].push_back(jobToJson(jobs[i], i));
+        std::string body = response.dump();
+        benchmark::DoNotOptimize(body.data());
+        state.counters["bytes_per_job"] = (double)body.size() / jobs.size();
+    }
+    state.SetItemsProcessed(state.iterations() * jobs.size());
+}
+BENCHMARK(BM_JobToJson)->Apply(catalogSizes);
+
+// The same listing streamed by JsonWriter into a buffer reserved from the previous size
+void BM_JobJsonWriter(benchmark::State& state) {
+    const auto& jobs = catalog(state.range(0));
+    ResponseSizeHint sizeHint(4096);
+    for (auto _ : state) {
+        std::string body;
+        body.reserve(sizeHint.get());
+        JsonWriter out(body);
+        out.beginObject();
+        out.key("jobs");
+        out.beginArray();
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            out.beginObject();
+            writeJobFields(out, jobs[i], i);
+            out.endObject();
+        }
+        out.endArray();
+        out.endObject();
+        sizeHint.update(body.size());
+        benchmark::DoNotOptimize(body.data());
+        state.counters["bytes_per_job"] = (double)body.size() / jobs.size();
+    }
+    state.SetItemsProcessed(state.iterations() * jobs.size());
+}
+BENCHMARK(BM_JobJsonWriter)->Apply(catalogSizes);
+
+// The listing in each wire format: encode time and bytes per job, then what a client pays to decode it
+std::string renderListing(WireFormat format, const std::vector<Job>& jobs) {
+    return renderAs(format, jobs.size() * 256, [&](auto& out) {
+        out.beginObject();
+        out.key("jobs");
+        out.beginArray();
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            out.beginObject();
+            writeJobFields(out, jobs[i], i);
+            out.endObject();
+        }
+        out.endArray();
+        out.endObject();
+    });
+}
+
+void BM_EncodeListing(benchmark::State& state, WireFormat format) {
+    const auto& jobs = catalog(state.range(0));
+    size_t bytes = 0;
+    for (auto _ : state) {
+        std::string body = renderListing(format, jobs);
+        bytes = body.size();
+        benchmark::DoNotOptimize(body.data());
+    }
+    state.counters["bytes_per_job"] = (double)bytes / jobs.size();
+    state.SetItemsProcessed(state.iterations() * jobs.size());
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK_CAPTURE(BM_EncodeListing, json, WireFormat::Json)->Apply(catalogSizes);
+BENCHMARK_CAPTURE(BM_EncodeListing, msgpack, WireFormat::MsgPack)->Apply(catalogSizes);
+BENCHMARK_CAPTURE(BM_EncodeListing, cbor, WireFormat::Cbor)->Apply(catalogSizes);
+
+void BM_DecodeListing(benchmark::State& state, WireFormat format) {
+    std::string body = renderListing(format, catalog(state.range(0)));
+    for (auto _ : state) {
+        nlohmann::json decoded = format == WireFormat::MsgPack ? nlohmann::json::from_msgpack(body)
+                                 : format == WireFormat::Cbor  ? nlohmann::json::from_cbor(body)
+                                                               : nlohmann::json::parse(body);
+        benchmark::DoNotOptimize(decoded);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * body.size());
+}
+BENCHMARK_CAPTURE(BM_DecodeListing, json, WireFormat::Json)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_DecodeListing, msgpack, WireFormat::MsgPack)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_DecodeListing, cbor, WireFormat::Cbor)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+// The catalog as POST /api/jobs bodies, one per job
+const std::vector<std::string>& postBodies(size_t n) {
+    static size_t cachedSize = 0;
+    static std::vector<std::string> bodies;
+    if (cachedSize != n) {
+        bodies.clear();
+        for (const auto& job : catalog(n)) bodies.push_back(jobToJson(job).dump());
+        cachedSize = n;
+    }
+    return bodies;
+}
+
+// Ingest parsing: DOM (json::parse, then copy out each field) against one SAX pass into the Job
+void BM_ParseJobDom(benchmark::State& state) {
+    const auto& bodies = postBodies(state.range(0));
+    size_t bytes = 0;
+    for (const auto& body : bodies) bytes += body.size();
+    for (auto _ : state) {
+        for (const auto& body : bodies) benchmark::DoNotOptimize(jobFromJson(nlohmann::json::parse(body)));
+    }
+    state.SetItemsProcessed(state.iterations() * bodies.size());
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_ParseJobDom)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+void BM_ParseJobSax(benchmark::State& state) {
+    const auto& bodies = postBodies(state.range(0));
+    size_t bytes = 0;
+    for (const auto& body : bodies) bytes += body.size();
+    for (auto _ : state) {
+        for (const auto& body : bodies) benchmark::DoNotOptimize(jobFromJsonText(body));
+    }
+    state.SetItemsProcessed(state.iterations() * bodies.size());
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_ParseJobSax)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+// Interns the catalog's skills and locations as the server's indexJob does and builds the skill matrix and embeddings
+struct ScoredCatalog {
+    std::vector<Job> jobs;
+    StringInterner skillNames;
+    StringInterner locationNames;
+    SkillMatrix matrix;
+    SkillEmbeddings embeddings;
+    Gazetteer gazetteer; // Loaded from data/gazetteer.tsv when run from the repo root, else empty
+};
+
+void internCatalog(ScoredCatalog& scored) {
+    scored.gazetteer.load("data/gazetteer.tsv");
+    for (auto& job : scored.jobs) {
+        for (const auto& skill : job.skills) job.skillIds.push_back(scored.skillNames.intern(toLower(skill)));
+        std::sort(job.skillIds.begin(), job.skillIds.end());
+        job.skillIds.erase(std::unique(job.skillIds.begin(), job.skillIds.end()), job.skillIds.end());
+        job.locationId = scored.locationNames.intern(toLower(job.location));
+        job.placeId = scored.gazetteer.resolve(job.location);
+        scored.matrix.addJob(job.skillIds);
+        scored.embeddings.addJob(job.skillIds);
+        if (scored.embeddings.rebuildDue()) scored.embeddings.rebuild();
+    }
+}
+
+void BM_SkillMatrixIngest(benchmark::State& state) {
+    const auto& jobs = catalog(state.range(0));
+    for (auto _ : state) {
+        ScoredCatalog scored;
+        scored.jobs = jobs;
+        internCatalog(scored);
+        benchmark::DoNotOptimize(scored.matrix.nonZeros());
+    }
+    state.SetItemsProcessed(state.iterations() * jobs.size());
+}
+BENCHMARK(BM_SkillMatrixIngest)->Apply(catalogSizes);
+
+// 256 candidates, each asking for one job's skills; every fourth also pins that job's location,
+// every eighth within 100 km of it
+void BM_RecommendBatch(benchmark::State& state) {
+    ScoredCatalog scored;
+    scored.jobs = catalog(state.range(0));
+    internCatalog(scored);
+    std::vector<Candidate> candidates(256);
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        const Job& job = scored.jobs[i * 7919 % scored.jobs.size()];
+        candidates[i].skills = job.skills;
+        if (i % 4 == 0) candidates[i].preferredLocation = job.location;
+        if (i % 8 == 0) candidates[i].radiusKm = 100;
+        candidates[i].expectedSalary = (i % 3) * 50000;
+    }
+    for (auto _ : state) {
+        auto top = recommendJobsBatch(scored.jobs, scored.matrix, scored.skillNames, scored.locationNames, scored.embeddings, scored.gazetteer, candidates, 10, nullptr);
+        benchmark::DoNotOptimize(top.data());
+    }
+    state.SetItemsProcessed(state.iterations() * candidates.size());
+}
+BENCHMARK(BM_RecommendBatch)->Apply(catalogSizes);
+
+// Similar-skill lookup for a five-skill profile: the constant similarity matching adds per profile
+void BM_SkillRelated(benchmark::State& state) {
+    ScoredCatalog scored;
+    scored.jobs = catalog(state.range(0));
+    internCatalog(scored);
+    std::vector<uint32_t> profile;
+    for (const char* skill : {"javascript", "sql", "docker", "python", "react"}) profile.push_back(scored.skillNames.find(skill));
+    std::sort(profile.begin(), profile.end());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(scored.embeddings.related(profile).data());
+    }
+    state.counters["skills"] = scored.embeddings.skillCount();
+}
+BENCHMARK(BM_SkillRelated)->Arg(100000);
+
+} // namespace
+
+BENCHMARK_MAIN();
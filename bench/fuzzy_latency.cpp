@@ -0,0 +1,90 @@
+// Latency budget check for typo-tolerant term expansion (Trie x Levenshtein automaton).
+// Builds a synthetic term dictionary, expands misspelled queries at edit distance 1 and 2,
+// and exits non-zero if the p99 expansion latency exceeds its budget.
+#include "Trie.h"
+#include "job_portal.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+const char* kTechTerms[] = {
+    "javascript", "typescript", "kubernetes", "python", "java", "golang", "rust", "react",
+    "angular", "docker", "terraform", "postgresql", "mongodb", "redis", "kafka", "spark",
+    "tensorflow", "pytorch", "django", "flask", "spring", "node.js", "graphql", "linux",
+};
+
+std::string randomTerm(std::mt19937& rng) {
+    static const char* syllables[] = {"ka", "ro", "ti", "ne", "sa", "lu", "mi", "do", "ve", "ra",
+                                      "po", "qu", "ex", "in", "or", "al", "ch", "st", "tr", "ng"};
+    std::uniform_int_distribution<int> count(2, 6), pick(0, 19);
+    std::string term;
+    for (int i = count(rng); i > 0; --i) term += syllables[pick(rng)];
+    return term;
+}
+
+// One random substitution, deletion, insertion or transposition
+std::string misspell(std::string term, std::mt19937& rng) {
+    std::uniform_int_distribution<size_t> pos(0, term.size() - 2);
+    std::uniform_int_distribution<int> kind(0, 3), letter('a', 'z');
+    size_t i = pos(rng);
+    switch (kind(rng)) {
+        case 0: term[i] = (char)letter(rng); break;
+        case 1: term.erase(i, 1); break;
+        case 2: term.insert(term.begin() + i, (char)letter(rng)); break;
+        default: std::swap(term[i], term[i + 1]); break;
+    }
+    return term;
+}
+
+double percentile(std::vector<double> samples, double p) {
+    std::sort(samples.begin(), samples.end());
+    return samples[std::min(samples.size() - 1, (size_t)(p * samples.size()))];
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t dictionarySize = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    const double budgetMicros[] = {0, 200, 2000}; // p99 budget per edit distance
+
+    std::mt19937 rng(42);
+    Trie termTrie;
+    std::vector<std::string> terms(std::begin(kTechTerms), std::end(kTechTerms));
+    while (terms.size() < dictionarySize) terms.push_back(randomTerm(rng));
+    for (const auto& term : terms) termTrie.insert(term);
+
+    bool withinBudget = true;
+    for (int maxEdits = 1; maxEdits <= 2; ++maxEdits) {
+        std::vector<double> micros;
+        size_t matches = 0;
+        std::uniform_int_distribution<size_t> pick(0, terms.size() - 1);
+        for (int i = 0; i < 2000; ++i) {
+            std::string query = misspell(terms[pick(rng)], rng);
+            auto start = std::chrono::steady_clock::now();
+            matches += termTrie.searchFuzzy(query, maxEdits).size();
+            auto end = std::chrono::steady_clock::now();
+            micros.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+        }
+        double p50 = percentile(micros, 0.50), p99 = percentile(micros, 0.99);
+        bool ok = p99 <= budgetMicros[maxEdits];
+        withinBudget = withinBudget && ok;
+        std::cout << "fuzzy_expand/edits:" << maxEdits << "/terms:" << terms.size()
+                  << "  p50=" << p50 << "us  p99=" << p99 << "us  budget=" << budgetMicros[maxEdits]
+                  << "us  avg_matches=" << (double)matches / micros.size() << (ok ? "  OK" : "  OVER BUDGET") << "\n";
+    }
+
+    // The misspellings from the request that motivated fuzzy search must resolve
+    for (const char* typo : {"javscript", "kuberentes"}) {
+        auto found = termTrie.searchFuzzy(typo, fuzzyEditBudget(typo));
+        bool hit = !found.empty();
+        std::cout << typo << " -> " << (hit ? found.front().term : "(none)") << "\n";
+        withinBudget = withinBudget && hit;
+    }
+    return withinBudget ? 0 : 1;
+}
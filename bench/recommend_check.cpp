@@ -0,0 +1,187 @@
+// Recommendation results against a brute-force reference over the raw catalog.
+// Half the catalog is indexed before the profiles are stored and half after, so the per-session
+// lists are filled partly from the skill matrix and partly by ingest pushes; batch top-K runs on
+// the full catalog. A few jobs and profiles list hundreds of skills, so the weighted sums of the
+// batch product run far past 16 bits. Exits non-zero on any mismatch.
+#include "geo.h"
+#include "job_portal.h"
+#include "recommendations.h"
+#include "skill_embeddings.h"
+#include "sparse_scoring.h"
+#include "string_interner.h"
+#include "workload.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+// The serving indexes recommendations read, filled the way indexJob fills them
+struct Catalog {
+    std::vector<Job> jobs;
+    StringInterner skillNames;
+    StringInterner locationNames;
+    Gazetteer gazetteer;
+    SkillMatrix matrix;
+    SkillEmbeddings embeddings;
+    RecommendationSubscriptions subscriptions;
+
+    void add(Job job) {
+        for (const auto& skill : job.skills) job.skillIds.push_back(skillNames.intern(toLower(skill)));
+        std::sort(job.skillIds.begin(), job.skillIds.end());
+        job.skillIds.erase(std::unique(job.skillIds.begin(), job.skillIds.end()), job.skillIds.end());
+        job.locationId = locationNames.intern(toLower(job.location));
+        job.placeId = gazetteer.resolve(job.location);
+        jobs.push_back(std::move(job));
+        matrix.addJob(jobs.back().skillIds);
+        embeddings.addJob(jobs.back().skillIds);
+        if (embeddings.rebuildDue()) embeddings.rebuild();
+        subscriptions.publish(jobs, jobs.size() - 1, skillNames, locationNames);
+    }
+};
+
+// Every job sharing a skill, exactly or through a similar one, that meets location and salary;
+// ascending job id. Overlap is counted straight from the job's skill list.
+std::vector<ScoredJob> reference(const Catalog& catalog, const std::vector<uint32_t>& skillIds,
+                                 const std::vector<std::pair<uint32_t, float>>& related, const LocationPreference& where,
+                                 double minSalary) {
+    std::vector<ScoredJob> matches;
+    for (size_t jobId = 0; jobId < catalog.jobs.size(); ++jobId) {
+        const Job& job = catalog.jobs[jobId];
+        if (job.salary < minSalary || !where.accepts(job)) continue;
+        ScoredJob scored{(int)jobId, 0, 0, 0};
+        for (uint32_t skillId : job.skillIds) {
+            if (std::binary_search(skillIds.begin(), skillIds.end(), skillId)) {
+                scored.matchedSkills++;
+                scored.skillScore += 1;
+                continue;
+            }
+            auto similar = std::lower_bound(related.begin(), related.end(), std::make_pair(skillId, -1.0f));
+            if (similar != related.end() && similar->first == skillId) {
+                scored.similarSkills++;
+                scored.skillScore += similar->second;
+            }
+        }
+        if (scored.matchedSkills + scored.similarSkills > 0) matches.push_back(scored);
+    }
+    return matches;
+}
+
+bool sameMatch(const ScoredJob& a, int jobId, int matched, int similar, float score) {
+    return a.jobIndex == jobId && a.matchedSkills == matched && a.similarSkills == similar && a.skillScore == score;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000;
+    size_t sessions = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 300;
+    std::string gazetteerPath = argc > 3 ? argv[3] : "data/gazetteer.tsv";
+    const size_t K = 10, WideSkills = 300;
+
+    Catalog catalog;
+    if (catalog.gazetteer.load(gazetteerPath) < 0) std::cerr << "Gazetteer " << gazetteerPath << " not found; radius queries match nothing extra\n";
+
+    std::vector<Job> jobs = generateJobs(n);
+    WorkloadGenerator generator;
+    std::vector<Candidate> candidates;
+    for (size_t i = 0; i < sessions; ++i) {
+        Candidate candidate = generator.nextCandidate();
+        if (i % 4 == 0 && !candidate.preferredLocation.empty()) candidate.radiusKm = 150;
+        candidates.push_back(std::move(candidate));
+    }
+
+    // Jobs and profiles listing more skills than a 16-bit weighted sum can count
+    std::vector<std::string> wide;
+    for (const auto& job : jobs) wide.insert(wide.end(), job.skills.begin(), job.skills.end());
+    std::sort(wide.begin(), wide.end());
+    wide.erase(std::unique(wide.begin(), wide.end()), wide.end());
+    for (size_t i = 0; wide.size() < WideSkills; ++i) wide.push_back("wide-skill-" + std::to_string(i));
+    for (size_t i = 0; i < 20; ++i) { // 240 to 297 skills, so sums wrapping at 16 bits would reorder them
+        Job job = jobs[i];
+        job.skills.assign(wide.begin(), wide.begin() + 240 + 3 * i);
+        jobs.insert(jobs.begin() + (i + 1) * jobs.size() / 21, std::move(job));
+    }
+    for (size_t i = 0; i < 5; ++i) {
+        Candidate candidate = candidates[i];
+        candidate.skills = wide;
+        candidate.expectedSalary = 0;
+        candidates.push_back(std::move(candidate));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    size_t half = jobs.size() / 2;
+    for (size_t i = 0; i < half; ++i) catalog.add(jobs[i]);
+    std::vector<std::shared_ptr<RecommendationState>> states;
+    for (const auto& candidate : candidates) {
+        auto state = resolveProfile(candidate, catalog.skillNames, catalog.locationNames, catalog.embeddings, catalog.gazetteer);
+        extendRecommendations(*state, catalog.jobs, catalog.matrix, catalog.skillNames, catalog.locationNames);
+        catalog.subscriptions.subscribe(state);
+        states.push_back(std::move(state));
+    }
+    for (size_t i = half; i < jobs.size(); ++i) catalog.add(jobs[i]);
+    double ingestSeconds = secondsSince(start);
+
+    size_t perSessionMatches = 0, perSessionErrors = 0;
+    for (size_t i = 0; i < states.size(); ++i) {
+        const RecommendationState& state = *states[i];
+        auto expected = reference(catalog, state.skillIds, state.relatedSkills, state.where, state.minSalary);
+        bool ok = expected.size() == state.matches.size();
+        for (size_t m = 0; ok && m < expected.size(); ++m) {
+            const RecommendationMatch& got = state.matches[m];
+            ok = sameMatch(expected[m], got.jobId, got.matchedSkills, got.similarSkills, got.skillScore);
+        }
+        perSessionMatches += expected.size();
+        if (!ok && perSessionErrors++ < 5) {
+            std::cout << "per_session mismatch: session " << i << " expected " << expected.size() << " matches, got " << state.matches.size() << "\n";
+        }
+    }
+
+    ThreadPool pool(3);
+    start = std::chrono::steady_clock::now();
+    auto top = recommendJobsBatch(catalog.jobs, catalog.matrix, catalog.skillNames, catalog.locationNames, catalog.embeddings,
+                                  catalog.gazetteer, candidates, K, &pool);
+    double batchSeconds = secondsSince(start);
+    size_t batchErrors = 0;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        const Candidate& candidate = candidates[i];
+        std::vector<uint32_t> skillIds;
+        for (const auto& skill : candidate.skills) {
+            uint32_t id = catalog.skillNames.find(toLower(skill));
+            if (id != StringInterner::NotFound) skillIds.push_back(id);
+        }
+        std::sort(skillIds.begin(), skillIds.end());
+        skillIds.erase(std::unique(skillIds.begin(), skillIds.end()), skillIds.end());
+        std::string location = toLower(candidate.preferredLocation);
+        LocationPreference where = resolveLocationPreference(location, location.empty() ? 0 : std::max(0.0, candidate.radiusKm),
+                                                             catalog.locationNames, catalog.gazetteer);
+        auto expected = reference(catalog, skillIds, catalog.embeddings.related(skillIds), where, candidate.expectedSalary);
+        std::stable_sort(expected.begin(), expected.end(), [](const ScoredJob& a, const ScoredJob& b) {
+            if (a.matchedSkills != b.matchedSkills) return a.matchedSkills > b.matchedSkills;
+            return a.skillScore > b.skillScore;
+        });
+        if (expected.size() > K) expected.resize(K);
+        bool ok = expected.size() == top[i].size();
+        for (size_t m = 0; ok && m < expected.size(); ++m) {
+            const ScoredJob& got = top[i][m];
+            ok = sameMatch(expected[m], got.jobIndex, got.matchedSkills, got.similarSkills, got.skillScore);
+        }
+        if (!ok && batchErrors++ < 5) {
+            std::cout << "batch mismatch: candidate " << i << " expected " << expected.size() << " jobs, got " << top[i].size() << "\n";
+        }
+    }
+
+    std::cout << "per_session/jobs:" << catalog.jobs.size() << "/sessions:" << states.size() << "  matches=" << perSessionMatches
+              << "  ingest=" << ingestSeconds << "s" << (perSessionErrors ? "  MISMATCH (" + std::to_string(perSessionErrors) + ")" : "  OK") << "\n";
+    std::cout << "batch/jobs:" << catalog.jobs.size() << "/candidates:" << candidates.size() << "  k=" << K << "  " << batchSeconds << "s"
+              << (batchErrors ? "  MISMATCH (" + std::to_string(batchErrors) + ")" : "  OK") << "\n";
+    return perSessionErrors || batchErrors ? 1 : 0;
+}
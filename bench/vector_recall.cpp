@@ -0,0 +1,112 @@
+// Recall and latency of the HNSW index against exact (brute-force) search.
+// Indexes clustered random unit vectors, sweeps the search beam width, and exits non-zero
+// if recall@10 at the serving beam width falls below its floor. Then reports how many
+// distinct skill-set vectors the synthetic catalog actually produces.
+#include "hnsw_index.h"
+#include "job_portal.h"
+#include "job_vectors.h"
+#include "workload.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+const size_t Dim = SkillEmbeddings::Dim;
+
+double percentile(std::vector<double> samples, double p) {
+    std::sort(samples.begin(), samples.end());
+    return samples[std::min(samples.size() - 1, (size_t)(p * samples.size()))];
+}
+
+double microsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Unit vectors scattered around `clusters` random centres, like jobs around role archetypes
+std::vector<float> clusteredVectors(size_t n, size_t clusters, std::mt19937& rng) {
+    std::normal_distribution<float> normal;
+    std::vector<float> centres(clusters * Dim), vectors(n * Dim);
+    for (auto& x : centres) x = normal(rng);
+    std::uniform_int_distribution<size_t> pick(0, clusters - 1);
+    for (size_t i = 0; i < n; ++i) {
+        float* v = &vectors[i * Dim];
+        const float* centre = &centres[pick(rng) * Dim];
+        for (size_t d = 0; d < Dim; ++d) v[d] = centre[d] + 0.6f * normal(rng);
+        float norm = std::sqrt(dotProduct(v, v, Dim));
+        for (size_t d = 0; d < Dim; ++d) v[d] /= norm;
+    }
+    return vectors;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    const size_t K = 10, Queries = 500, ServingEf = 64;
+    const double RecallFloor = 0.9;
+
+    std::mt19937 rng(42);
+    // Queries come from the same distribution as the indexed vectors but are not indexed
+    std::vector<float> vectors = clusteredVectors(n + Queries, 200, rng);
+    std::vector<float> queries(vectors.end() - Queries * Dim, vectors.end());
+
+    HnswIndex index(Dim, HnswIndex::Params{});
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < n; ++i) index.add(&vectors[i * Dim]);
+    double buildMicros = microsSince(start);
+    std::cout << "hnsw_build/vectors:" << n << "  " << buildMicros / 1e6 << "s  (" << buildMicros / n << "us per insert)\n";
+
+    std::vector<std::vector<std::pair<uint32_t, float>>> exact;
+    std::vector<double> exactMicros;
+    for (size_t q = 0; q < Queries; ++q) {
+        start = std::chrono::steady_clock::now();
+        exact.push_back(index.exactSearch(&queries[q * Dim], K));
+        exactMicros.push_back(microsSince(start));
+    }
+    std::cout << "exact/vectors:" << n << "  p50=" << percentile(exactMicros, 0.5) << "us  p99=" << percentile(exactMicros, 0.99) << "us\n";
+
+    bool ok = true;
+    for (size_t ef : {16, 32, 64, 128, 256}) {
+        std::vector<double> micros;
+        size_t hits = 0;
+        for (size_t q = 0; q < Queries; ++q) {
+            start = std::chrono::steady_clock::now();
+            auto found = index.search(&queries[q * Dim], K, ef);
+            micros.push_back(microsSince(start));
+            for (const auto& [id, similarity] : found) {
+                hits += std::any_of(exact[q].begin(), exact[q].end(), [id = id](const auto& e) { return e.first == id; });
+            }
+        }
+        double recall = (double)hits / (Queries * K);
+        bool serving = ef == ServingEf;
+        if (serving) ok = recall >= RecallFloor;
+        std::cout << "hnsw_search/ef:" << ef << "  recall@" << K << "=" << recall << "  p50=" << percentile(micros, 0.5)
+                  << "us  p99=" << percentile(micros, 0.99) << "us"
+                  << (serving ? (ok ? "  OK" : "  BELOW RECALL FLOOR") : "") << "\n";
+    }
+
+    // The serving index holds one node per distinct skill set, not one per job
+    std::vector<Job> jobs = generateJobs(n);
+    StringInterner skillNames;
+    SkillEmbeddings embeddings;
+    JobVectorIndex jobVectors(HnswIndex::Params{});
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        std::vector<uint32_t> skillIds;
+        for (const auto& skill : jobs[i].skills) skillIds.push_back(skillNames.intern(toLower(skill)));
+        std::sort(skillIds.begin(), skillIds.end());
+        skillIds.erase(std::unique(skillIds.begin(), skillIds.end()), skillIds.end());
+        embeddings.addJob(skillIds);
+        if (embeddings.rebuildDue()) embeddings.rebuild();
+        jobVectors.addJob(i, skillIds, embeddings);
+        if (jobVectors.relinkDue(embeddings)) jobVectors.relink(embeddings);
+    }
+    std::cout << "catalog/jobs:" << n << "  nodes=" << jobVectors.nodeCount() << "  rebuilds=" << jobVectors.rebuilds()
+              << "  ingest=" << microsSince(start) / 1e6 << "s\n";
+    return ok ? 0 : 1;
+}
@@ -1,15 +1,22 @@
 #ifndef CANDIDATE_H
 #define CANDIDATE_H
 
+#include <memory>
 #include <string>
 #include <vector>
 
+struct RecommendationState;
+
 struct Candidate {
     std::string name;
     std::vector<std::string> skills;
     std::string preferredLocation;
+    double radiusKm = 0; // Also accept jobs in gazetteer places this close to preferredLocation
     double expectedSalary;
     bool isProfileSet = false;
+
+    // Server only: the profile resolved to interned ids, with its recommendations so far
+    std::shared_ptr<RecommendationState> recommendations;
 };
 
 #endif // CANDIDATE_H
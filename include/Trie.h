@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include "levenshtein.h"
 
 class TrieNode {
 public:
@@ -16,14 +17,20 @@ public:
 class Trie {
 private:
     TrieNode* root;
+    size_t nodes = 1;
     void collectWords(TrieNode* node, std::string& currentPrefix, std::vector<std::string>& results) const;
     void clear(TrieNode* node); // Helper for destructor
+    void collectFuzzy(TrieNode* node, const LevenshteinAutomaton& automaton, std::vector<LevenshteinAutomaton::State>& rows,
+                      std::string& currentWord, std::vector<FuzzyMatch>& results) const;
 
 public:
     Trie();
     ~Trie(); // Destructor to free memory
     void insert(const std::string& word);
     std::vector<std::string> searchPrefix(const std::string& prefix) const;
+    // Words within maxEdits of word, closest first. Only branches the automaton can still accept are visited.
+    std::vector<FuzzyMatch> searchFuzzy(const std::string& word, int maxEdits) const;
+    size_t nodeCount() const { return nodes; }
 };
 
 #endif // TRIE_H
@@ -0,0 +1,19 @@
+#ifndef COMPRESSION_H
+#define COMPRESSION_H
+
+#include <string>
+#include <string_view>
+
+enum class ContentEncoding { Identity, Gzip, Deflate };
+
+// Picks the response encoding an Accept-Encoding header allows: gzip unless deflate has the
+// higher q-value; "*" covers both and q=0 rules an encoding out
+ContentEncoding negotiateEncoding(std::string_view acceptEncoding);
+// Content-Encoding header value
+const char* encodingName(ContentEncoding encoding);
+
+// zlib compression; Deflate is the zlib-wrapped stream HTTP's "deflate" means. Level 1 is
+// fastest, 9 smallest. Throws std::runtime_error if zlib fails.
+std::string compress(std::string_view data, ContentEncoding encoding, int level);
+
+#endif // COMPRESSION_H
@@ -3725,6 +3725,9 @@ namespace crow
             virtual void send_pong(const std::string& msg) = 0;
             virtual void close(const std::string& msg = "quit") = 0;
             virtual std::string get_remote_ip() = 0;
+            /// Run a handler on the connection's own thread, where it is also closed and destroyed.
+            virtual void dispatch(std::function<void()> handler) = 0;
+            virtual void post(std::function<void()> handler) = 0;
             virtual ~connection() {}
 
             void userdata(void* u) { userdata_ = u; }
@@ -3804,15 +3807,13 @@ namespace crow
             }
 
             /// Send data through the socket.
-            template<typename CompletionHandler>
-            void dispatch(CompletionHandler handler)
+            void dispatch(std::function<void()> handler) override
             {
                 adaptor_.get_io_service().dispatch(handler);
             }
 
             /// Send data through the socket and return immediately.
-            template<typename CompletionHandler>
-            void post(CompletionHandler handler)
+            void post(std::function<void()> handler) override
             {
                 adaptor_.get_io_service().post(handler);
             }
@@ -11298,7 +11299,8 @@ namespace crow
                 buffers_.clear();
                 static std::string expect_100_continue = "HTTP/1.1 100 Continue\r\n\r\n";
                 buffers_.emplace_back(expect_100_continue.data(), expect_100_continue.size());
-                do_write();
+                // Written synchronously: do_write()'s completion clears the parser, which would drop the body still to come
+                do_write_sync(buffers_);
             }
         }
 
@@ -0,0 +1,29 @@
+#ifndef FACETS_H
+#define FACETS_H
+
+#include "job.h"
+#include <cstdint>
+#include <vector>
+
+struct FacetBucket {
+    uint32_t id; // Interned skill or location id
+    uint32_t count;
+};
+
+struct Facets {
+    std::vector<FacetBucket> skills;    // Most common first, at most topN
+    std::vector<FacetBucket> locations; // Most common first, at most topN
+    std::vector<uint32_t> salaryHistogram; // One count per salary bucket
+};
+
+// Lower bounds of the salary histogram buckets; the last bucket is open-ended
+const std::vector<double>& salaryBucketEdges();
+size_t salaryBucket(double salary);
+
+// Counts skills, locations and salary buckets over every matched job.
+// Counting uses per-thread arrays indexed by interned id; only the slots a query
+// touched are reset afterwards, so the cost follows the match set, not the vocabulary.
+Facets computeFacets(const std::vector<Job>& jobs, const std::vector<int>& matched,
+                     size_t skillCount, size_t locationCount, size_t topN);
+
+#endif // FACETS_H
@@ -0,0 +1,65 @@
+#ifndef GEO_H
+#define GEO_H
+
+#include "job.h"
+#include "string_interner.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+struct Place {
+    std::string name;
+    double lat;
+    double lon;
+};
+
+// Great-circle distance in km
+double haversineKm(double lat1, double lon1, double lat2, double lon2);
+
+// Offline gazetteer: place names and aliases resolved to coordinates, with a grid over the
+// places for radius queries. Cells are GridDegrees on a side, so a radius query visits only
+// the cells overlapping its bounding box instead of every place.
+class Gazetteer {
+public:
+    static constexpr uint32_t NoPlace = UINT32_MAX;
+    static constexpr double GridDegrees = 1.0;
+
+    // Reads "name<TAB>lat<TAB>lon<TAB>aliases" lines ('#' starts a comment); returns the places
+    // loaded, or -1 if the file cannot be opened. Bad lines are skipped.
+    long load(const std::string& path);
+    uint32_t add(const std::string& name, double lat, double lon, const std::vector<std::string>& aliases);
+
+    // Case-insensitive; "Pune, India" falls back to its part before the first comma
+    uint32_t resolve(std::string_view location) const;
+    const Place& place(uint32_t id) const { return places[id]; }
+    size_t size() const { return places.size(); }
+    // Places within radiusKm of (lat, lon), ascending id
+    std::vector<uint32_t> within(double lat, double lon, double radiusKm) const;
+    std::vector<uint32_t> within(uint32_t placeId, double radiusKm) const;
+
+private:
+    std::vector<Place> places;
+    std::unordered_map<std::string, uint32_t> byName; // Lowercased name or alias -> place
+    std::unordered_map<int64_t, std::vector<uint32_t>> grid;
+
+    static int64_t cellKey(long row, long col) { return (int64_t)row << 32 | (uint32_t)col; }
+};
+
+// A preferred location resolved against the catalog's interned locations and the gazetteer.
+// A job matches if its location is the same string, or a place within radiusKm of the preferred
+// place, so aliases ("Bengaluru" for "Bangalore") match at radius 0.
+struct LocationPreference {
+    std::string location;                             // Lowercased; empty accepts every location
+    uint32_t locationId = StringInterner::NotFound;
+    std::vector<uint32_t> places;                     // Gazetteer places in range, ascending; empty if unknown
+
+    bool acceptsAll() const { return location.empty(); }
+    bool accepts(const Job& job) const;
+};
+
+LocationPreference resolveLocationPreference(const std::string& location, double radiusKm, const StringInterner& locationNames,
+                                             const Gazetteer& gazetteer);
+
+#endif // GEO_H
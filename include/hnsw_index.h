@@ -0,0 +1,61 @@
+#ifndef HNSW_INDEX_H
+#define HNSW_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Hierarchical navigable small world graph over unit-length vectors, for approximate
+// nearest-neighbour search by cosine similarity (Malkov & Yashunin). Each vector sits on
+// layers 0..level, with level drawn geometrically; a search descends greedily from the top
+// layer and runs a best-first beam of width `ef` on layer 0. Insertion is incremental.
+// Searches only read, so they may run concurrently with each other but not with add().
+class HnswIndex {
+public:
+    struct Params {
+        size_t M = 16;               // Links per node per layer (2*M on layer 0)
+        size_t efConstruction = 64;  // Beam width while linking a new node
+        uint32_t seed = 42;
+    };
+
+    HnswIndex(size_t dim, Params params);
+
+    // Stores a copy of the vector under the next id (0, 1, 2, ...)
+    uint32_t add(const float* vector);
+    // Up to k (id, cosine similarity) pairs, most similar first; ef >= k trades latency for recall
+    std::vector<std::pair<uint32_t, float>> search(const float* query, size_t k, size_t ef) const;
+    // Brute-force reference for search(), O(size * dim)
+    std::vector<std::pair<uint32_t, float>> exactSearch(const float* query, size_t k) const;
+
+    size_t size() const { return levels.size(); }
+    const float* vector(uint32_t id) const { return &data[id * dim]; }
+
+private:
+    using Scored = std::pair<float, uint32_t>; // Distance (1 - cosine), id
+
+    size_t dim;
+    Params params;
+    double levelScale;
+    std::mt19937 rng;
+
+    std::vector<float> data;      // size() x dim
+    std::vector<int> levels;      // Top layer of each node
+    std::vector<uint32_t> layer0; // size() x (1 + 2*M): neighbour count, then neighbours; flat for locality
+    std::vector<std::vector<std::vector<uint32_t>>> upperLinks; // Node -> layer-1 -> neighbours, for the few nodes above layer 0
+    uint32_t entryPoint = 0;
+    int maxLevel = -1;
+
+    float distance(const float* query, uint32_t id) const;
+    // Neighbours of `node` on `layer` as [begin, end)
+    std::pair<const uint32_t*, const uint32_t*> neighbours(uint32_t node, int layer) const;
+    void setNeighbours(uint32_t node, int layer, const std::vector<uint32_t>& ids);
+    // The ef nearest nodes reachable on `layer` from `entry`, nearest first
+    std::vector<Scored> searchLayer(const float* query, uint32_t entry, size_t ef, int layer) const;
+    // Keeps up to m of the (nearest-first) candidates, preferring ones not already covered by a
+    // closer kept neighbour, so links span clusters instead of crowding into one
+    std::vector<uint32_t> selectNeighbors(const std::vector<Scored>& candidates, size_t m) const;
+};
+
+#endif // HNSW_INDEX_H
@@ -1,6 +1,7 @@
 #ifndef JOB_H
 #define JOB_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -12,6 +13,11 @@ struct Job {
     std::string description; // Added for more detailed info
     double salary;
     std::vector<std::string> tags;
+
+    // Interned lowercase skill/location ids, assigned by the server on ingest
+    std::vector<uint32_t> skillIds;
+    uint32_t locationId = 0;
+    uint32_t placeId = UINT32_MAX; // Gazetteer place of `location`; UINT32_MAX if unknown
 };
 
 #endif // JOB_H
@@ -0,0 +1,46 @@
+#ifndef JOB_JSON_H
+#define JOB_JSON_H
+
+#include "job.h"
+#include "Candidate.h"
+#include <nlohmann/json.hpp>
+#include <string>
+#include <string_view>
+
+// Helper function to convert Job to JSON
+nlohmann::json jobToJson(const Job& job, int index = -1);
+// Reads a job posting (title, company, location, salary, skills, optional description); throws on bad fields
+Job jobFromJson(const nlohmann::json& body);
+
+// jobToJson's fields, written into an object the caller has begun so it can append its own
+// (score, distance, ...) before ending it. Templated on the writer (JsonWriter, ...).
+template <class Writer>
+void writeJobFields(Writer& out, const Job& job, int index = -1) {
+    if (index >= 0) {
+        out.key("id");
+        out.integer(index);
+    }
+    out.key("title");
+    out.string(job.title);
+    out.key("company");
+    out.string(job.company);
+    out.key("location");
+    out.string(job.location);
+    out.key("salary");
+    out.number(job.salary);
+    out.key("skills");
+    out.beginArray();
+    for (const auto& skill : job.skills) out.string(skill);
+    out.endArray();
+    out.key("description");
+    out.string(job.description);
+}
+
+// Request bodies read in one SAX pass over the text, without building a DOM: string values are
+// moved from the parser's token buffer into the result, and unknown fields are skipped.
+// Throws std::invalid_argument on malformed JSON, a missing field or a field of the wrong type.
+Job jobFromJsonText(std::string_view text);
+// A profile update: name, location, salary, skills, optional radiusKm and sessionId ("default")
+Candidate candidateFromJsonText(std::string_view text, std::string& sessionId);
+
+#endif // JOB_JSON_H
@@ -4,6 +4,11 @@
 #include "job.h"
 #include "Candidate.h"
 #include "Trie.h"
+#include "geo.h"
+#include "skill_embeddings.h"
+#include "sparse_scoring.h"
+#include "string_interner.h"
+#include "thread_pool.h"
 #include <vector>
 #include <string>
 #include <unordered_map>
@@ -14,16 +19,44 @@ using InvertedIndex = std::unordered_map<std::string, std::vector<int>>;
 // Search relevance scoring
 int relevanceScore(const Job& job, const std::string& keyword);
 
+// --- Typo-Tolerant Search ---
+// Edit budget for a query term: exact for short terms, 1 edit up to 5 chars, 2 beyond
+int fuzzyEditBudget(const std::string& term);
+// Lowercased title words and skills, as stored in the term dictionary
+std::vector<std::string> jobTerms(const Job& job);
+// For each query word, the dictionary terms within its edit budget (closest first)
+std::vector<std::vector<std::string>> expandFuzzyTerms(const Trie& termTrie, const std::string& query);
+// Sum over query words of the best relevanceScore among that word's expansions
+int fuzzyRelevanceScore(const Job& job, const std::vector<std::vector<std::string>>& expansions);
+
 // --- Utility Functions ---
 void printJob(const Job& job);
 std::string toLower(std::string s);
 std::vector<std::string> split(const std::string& s, char delimiter);
+std::vector<std::string> tokenize(const std::string& s); // Lowercased words; keeps '+', '#' and '.' for "c++", "c#", "node.js"
 
 // --- Core Application Logic ---
 void postJob(std::vector<Job>& jobs, InvertedIndex& skillIndex, InvertedIndex& locationIndex, Trie& jobTitleTrie);
 void updateCandidateProfile(Candidate& candidate);
 void searchJobs(const std::vector<Job>& jobs);
 void recommendJobs(const std::vector<Job>& jobs, const InvertedIndex& skillIndex, const Candidate& candidate);
+// A recommended job with how it matched: exact skills, skills matched only through
+// SkillEmbeddings similarity, and 1 per exact match plus the similarity of each similar one
+struct ScoredJob {
+    int jobIndex;
+    int matchedSkills;
+    int similarSkills;
+    float skillScore;
+};
+// Top K jobs per candidate, most matched skills first, then highest skillScore, lower job index on
+// ties; same matching rules as recommendJobs, plus jobs requiring only skills similar to the
+// candidate's. Candidates with the same skills, location and radius form one row of a sparse product
+// against the job-skill matrix, and blocks of rows are spread over the calling thread and `pool`'s
+// workers (the calling thread alone if pool is null). The caller holds the catalog lock.
+std::vector<std::vector<ScoredJob>> recommendJobsBatch(const std::vector<Job>& jobs, const SkillMatrix& matrix,
+                                                       const StringInterner& skillNames, const StringInterner& locationNames,
+                                                       const SkillEmbeddings& embeddings, const Gazetteer& gazetteer,
+                                                       const std::vector<Candidate>& candidates, size_t K, ThreadPool* pool);
 void autocompleteSearch(const Trie& jobTitleTrie);
 
 #endif // JOB_PORTAL_H
@@ -0,0 +1,79 @@
+#ifndef JOB_VECTORS_H
+#define JOB_VECTORS_H
+
+#include "hnsw_index.h"
+#include "skill_embeddings.h"
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <utility>
+#include <vector>
+
+// Jobs indexed for "more like this" and vector recommendations. A job's vector is the
+// normalized sum of its skills' embeddings, so jobs with the same skill set share one: the
+// HNSW graph holds a node per distinct skill set, and each node lists its jobs. Embedding builds
+// stay nearly aligned, so new sets are linked against older vectors until the set count has
+// doubled since the last graph build; then the graph is relinked under the current embeddings,
+// keeping that amortized O(1) relinks per set. A relink builds a fresh graph from a snapshot of
+// the set vectors and swaps it in, linking the sets added meanwhile, so ingest never waits on it.
+// Callers hold the catalog lock: exclusively for addJob and install, none for build, shared for the rest.
+class JobVectorIndex {
+public:
+    // Every skill set's vector under one embeddings build
+    struct Snapshot {
+        HnswIndex::Params params;
+        size_t embeddingsVersion = 0;
+        size_t sets = 0;
+        std::vector<float> vectors;   // sets x Dim
+        std::vector<uint8_t> present; // Whether the set's row is a real vector
+    };
+    struct Build {
+        HnswIndex graph;
+        size_t embeddingsVersion;
+        std::vector<uint32_t> setNode; // For the snapshot's sets
+        std::vector<uint32_t> nodeSet;
+    };
+
+    explicit JobVectorIndex(HnswIndex::Params params);
+
+    // Indexes jobs[jobId] (ids arrive in order) by its ascending, unique skill ids
+    void addJob(int jobId, const std::vector<uint32_t>& skillIds, const SkillEmbeddings& embeddings);
+    // Whether the embeddings changed and the set count has doubled since the last relink
+    bool relinkDue(const SkillEmbeddings& embeddings) const;
+    Snapshot snapshot(const SkillEmbeddings& embeddings) const;
+    static Build build(Snapshot snapshot);
+    void install(Build next, const SkillEmbeddings& embeddings);
+    void relink(const SkillEmbeddings& embeddings) { install(build(snapshot(embeddings)), embeddings); }
+
+    // Normalized sum of the embedded skills' vectors; false if none of the skills has one
+    static bool skillSetVector(const std::vector<uint32_t>& skillIds, const SkillEmbeddings& embeddings, float* out);
+
+    // Up to `limit` (job id, cosine similarity) pairs passing `accept`, most similar first (jobs
+    // sharing a skill set in id order). The beam widens until enough jobs pass or the graph is exhausted.
+    std::vector<std::pair<int, float>> nearestJobs(const float* query, size_t limit, const std::function<bool(int)>& accept) const;
+    // Jobs most similar to jobs[jobId], excluding it; empty if the job has no vector
+    std::vector<std::pair<int, float>> similarJobs(int jobId, size_t limit) const;
+
+    size_t nodeCount() const { return graph.size(); }
+    size_t rebuilds() const { return rebuildCount; }
+
+private:
+    static constexpr uint32_t NoNode = UINT32_MAX;
+    static constexpr size_t MinEf = 64;
+
+    HnswIndex::Params params;
+    HnswIndex graph;
+    std::map<std::vector<uint32_t>, uint32_t> setIds; // Skill set -> set id
+    std::vector<std::vector<uint32_t>> setSkills;     // Set id -> skill ids
+    std::vector<std::vector<int>> setJobs;            // Set id -> ascending job ids
+    std::vector<uint32_t> setNode;                    // Set id -> graph node, or NoNode without a vector
+    std::vector<uint32_t> nodeSet;                    // Graph node -> set id
+    std::vector<uint32_t> jobSet;                     // Job id -> set id
+    size_t embeddingsVersion = 0;
+    size_t setsAtBuild = 0; // Skill sets when the graph was last relinked
+    size_t rebuildCount = 0;
+
+    void insertSet(uint32_t setId, const SkillEmbeddings& embeddings);
+};
+
+#endif // JOB_VECTORS_H
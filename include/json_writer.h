@@ -0,0 +1,74 @@
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Streaming JSON writer appending straight to a string, for responses that would otherwise be
+// built as a nlohmann DOM and then dumped. Commas are placed automatically; the caller keeps
+// begin/end calls balanced and writes a key before each value inside an object.
+class JsonWriter {
+public:
+    explicit JsonWriter(std::string& out) : out(out) {}
+
+    void beginObject() { open('{'); }
+    void endObject() { close('}'); }
+    void beginArray() { open('['); }
+    void endArray() { close(']'); }
+    void key(std::string_view name) {
+        separate();
+        appendString(name);
+        out += ':';
+        afterValue = false;
+    }
+
+    void string(std::string_view value) {
+        separate();
+        appendString(value);
+        afterValue = true;
+    }
+    void number(double value);          // Shortest round-trip form, "5.0" for integral values; null if not finite
+    void integer(int64_t value);
+    void boolean(bool value) { raw(value ? "true" : "false"); }
+    void null() { raw("null"); }
+    // An already rendered JSON value, e.g. from a cache
+    void raw(std::string_view json) {
+        separate();
+        out += json;
+        afterValue = true;
+    }
+
+private:
+    std::string& out;
+    bool afterValue = false; // A value or closed container precedes, so the next one needs a comma
+
+    void separate() {
+        if (afterValue) out += ',';
+    }
+    void open(char bracket) {
+        separate();
+        out += bracket;
+        afterValue = false;
+    }
+    void close(char bracket) {
+        out += bracket;
+        afterValue = true;
+    }
+    void appendString(std::string_view value);
+};
+
+// Recent response size for one kind of response, so its buffer is reserved once up front
+// instead of growing by doubling while it is written
+class ResponseSizeHint {
+public:
+    explicit ResponseSizeHint(size_t initial) : bytes(initial) {}
+    size_t get() const { return bytes.load(std::memory_order_relaxed); }
+    void update(size_t used) { bytes.store(used + used / 8, std::memory_order_relaxed); }
+
+private:
+    std::atomic<size_t> bytes;
+};
+
+#endif // JSON_WRITER_H
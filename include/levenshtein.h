@@ -0,0 +1,34 @@
+#ifndef LEVENSHTEIN_H
+#define LEVENSHTEIN_H
+
+#include <string>
+#include <vector>
+
+// A dictionary term found within the edit budget of a query word
+struct FuzzyMatch {
+    std::string term;
+    int distance;
+};
+
+// Levenshtein automaton for a fixed word and edit budget.
+// A state is one row of the edit-distance table (clamped to maxEdits + 1), so the
+// automaton can be stepped character by character alongside a Trie walk and the
+// walk can stop as soon as no completion of the current prefix can still match.
+class LevenshteinAutomaton {
+private:
+    std::string word;
+    int maxEdits;
+
+public:
+    using State = std::vector<int>;
+
+    LevenshteinAutomaton(const std::string& word, int maxEdits);
+
+    State start() const;
+    void step(const State& state, char ch, State& next) const;
+    bool isMatch(const State& state) const { return state.back() <= maxEdits; }
+    bool canMatch(const State& state) const;
+    int distance(const State& state) const { return state.back(); }
+};
+
+#endif // LEVENSHTEIN_H
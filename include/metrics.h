@@ -0,0 +1,86 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// HDR-style log-linear histogram of microsecond latencies: every power of two is
+// split into 8 linear sub-buckets, so any recorded value is off by at most 12.5%.
+// Buckets are atomics written by a single owning thread with relaxed ordering and
+// read concurrently by whoever aggregates.
+class LatencyHistogram {
+public:
+    static constexpr int SubBucketBits = 3;
+    static constexpr size_t SubBuckets = 1 << SubBucketBits;
+    static constexpr size_t BucketCount = SubBuckets * 40; // Up to ~2^40 us (12 days)
+
+    static size_t bucketFor(uint64_t micros);
+    static uint64_t bucketUpperBound(size_t bucket); // Largest value mapped to the bucket
+
+    void record(uint64_t micros);
+    void addTo(std::vector<uint64_t>& counts) const; // counts must have BucketCount entries
+
+private:
+    std::array<std::atomic<uint64_t>, BucketCount> buckets{};
+};
+
+// Value at quantile q (0..1) of merged histogram counts, as the bucket's upper bound
+uint64_t histogramQuantile(const std::vector<uint64_t>& counts, double q);
+
+// Per-route request counters kept per thread and summed on scrape.
+// Each serving thread lazily gets its own slot, so recording never contends;
+// only slot creation and scraping take the registry lock.
+class RequestMetrics {
+public:
+    // Routes must all be registered before the first request is recorded.
+    // A pattern segment "<int>" matches any run of digits; a final "<path>" matches the rest of the URL.
+    void addRoute(const std::string& method, const std::string& pattern);
+    // Gauges are evaluated on every scrape
+    void addGauge(const std::string& name, const std::string& help, std::function<double()> read);
+    // Likewise, for totals that never decrease while the process runs; name them *_total
+    void addCounter(const std::string& name, const std::string& help, std::function<double()> read);
+
+    void record(const std::string& method, const std::string& url, int status, size_t responseBytes, uint64_t micros);
+
+    // Prometheus text exposition format
+    std::string render() const;
+
+private:
+    struct Route {
+        std::string method;
+        std::string pattern;
+        std::vector<std::string> segments;
+    };
+    struct RouteCounters {
+        std::array<std::atomic<uint64_t>, 6> byStatusClass{}; // Index: status / 100 (0 = unknown)
+        std::atomic<uint64_t> responseBytes{0};
+        std::atomic<uint64_t> latencySumMicros{0};
+        LatencyHistogram latency;
+    };
+    struct ThreadSlot {
+        std::unique_ptr<RouteCounters[]> routes;
+    };
+    struct Scalar {
+        std::string name, help;
+        const char* type; // "gauge" or "counter"
+        std::function<double()> read;
+    };
+
+    std::vector<Route> routes; // Slot index routes.size() is the catch-all "other"
+    std::unordered_map<std::string, size_t> exactRoutes; // "METHOD path" -> route, for patterns without parameters
+    std::vector<Scalar> scalars;
+    mutable std::mutex registryMutex;
+    std::vector<std::shared_ptr<ThreadSlot>> slots;
+
+    size_t routeFor(const std::string& method, const std::string& url) const;
+    ThreadSlot& localSlot();
+};
+
+#endif // METRICS_H
@@ -0,0 +1,35 @@
+#ifndef NGRAM_INDEX_H
+#define NGRAM_INDEX_H
+
+#include "job.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Trigram index over lowercased job titles and skills.
+// Answers the same infix question as relevanceScore ("script" is in "JavaScript")
+// by intersecting the posting lists of the keyword's trigrams. The result is a
+// candidate set: a job can contain every trigram without containing the keyword,
+// so callers still verify each candidate with relevanceScore.
+class NgramIndex {
+private:
+    std::unordered_map<uint32_t, std::vector<int>> postings; // Trigram -> ascending job ids
+    int jobCount = 0;
+
+    void addField(int jobId, const std::string& lowerText);
+
+public:
+    static constexpr size_t N = 3;
+
+    // Jobs must be added in increasing id order so posting lists stay sorted
+    void addJob(int jobId, const Job& job);
+    // Ascending ids of jobs whose title or a skill may contain keyword.
+    // Keywords shorter than a trigram cannot be narrowed and return every job.
+    // Adds the number of posting entries walked to *postingsTouched when given.
+    std::vector<int> candidates(const std::string& keyword, size_t* postingsTouched = nullptr) const;
+
+    size_t trigramCount() const { return postings.size(); }
+};
+
+#endif // NGRAM_INDEX_H
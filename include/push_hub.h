@@ -0,0 +1,84 @@
+#ifndef PUSH_HUB_H
+#define PUSH_HUB_H
+
+#include "recommendations.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+// Outbox of one push connection. Ingest only appends to it; when it would exceed its
+// byte budget the oldest items are dropped and counted, so a slow client costs a
+// bounded amount of memory and never blocks the ingest path.
+class PushSubscriber : public MatchListener {
+public:
+    using Sender = std::function<void(const std::string&)>;
+    // Runs a handler on the connection's own thread, the only one that closes and destroys it
+    using Poster = std::function<void(std::function<void()>)>;
+
+    PushSubscriber(Poster post, Sender send, size_t maxQueuedBytes)
+        : post(std::move(post)), send(std::move(send)), maxQueuedBytes(maxQueuedBytes) {}
+    void onMatch(const std::string& renderedMatch) override;
+
+private:
+    friend class PushHub;
+
+    std::mutex mutex;
+    Poster post;
+    Sender send; // Only called from a handler run by `post`, while the connection is open
+    size_t maxQueuedBytes;
+    std::deque<std::string> queue;
+    size_t queuedBytes = 0;
+    uint64_t dropped = 0;    // Items dropped since the last batch went out
+    uint64_t lastBatch = 0;  // Sequence number of the last batch sent
+    uint64_t lastAcked = 0;  // Highest batch the client acknowledged
+};
+
+// Batches queued matches into one message per connection every interval. A client
+// acknowledges batches by sequence number; a connection with `maxInFlight` batches
+// unacknowledged gets nothing more until it catches up, which bounds what can pile
+// up in the socket's write buffers. Dropped items are reported in the next batch so
+// the client knows to re-read /api/recommendations.
+class PushHub {
+public:
+    struct Limits {
+        size_t maxQueuedBytes = 256 * 1024; // Per connection
+        uint64_t maxInFlight = 4;
+        size_t maxBatchItems = 256;
+        std::chrono::milliseconds batchInterval{100};
+    };
+    struct Stats {
+        uint64_t connections, queuedBytes, dropped, batches;
+    };
+
+    explicit PushHub(Limits limits);
+    ~PushHub(); // Stops the flusher
+
+    // Registers a connection; attach the returned subscriber to a RecommendationState's listeners
+    std::shared_ptr<PushSubscriber> open(const void* connection, PushSubscriber::Poster post, PushSubscriber::Sender send);
+    void ack(const void* connection, uint64_t batch);
+    // Idempotent; call it on the connection's thread, and once it returns the sender is never called again
+    void close(const void* connection);
+    Stats stats() const;
+
+private:
+    Limits limits;
+    mutable std::mutex mutex; // Guards the connection map
+    std::unordered_map<const void*, std::shared_ptr<PushSubscriber>> connections;
+    std::atomic<uint64_t> droppedTotal{0}, batchesTotal{0};
+    std::condition_variable wake;
+    bool stopping = false;
+    std::thread flusher;
+
+    void flushLoop();
+    void flush(const void* connection, const std::shared_ptr<PushSubscriber>& subscriber);
+};
+
+#endif // PUSH_HUB_H
@@ -0,0 +1,78 @@
+#ifndef QUERY_CACHE_H
+#define QUERY_CACHE_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Approximate access counts for TinyLFU admission: a count-min sketch of small
+// saturating counters that are halved periodically so old popularity fades.
+class FrequencySketch {
+private:
+    static constexpr int Depth = 4;
+    static constexpr uint8_t MaxCount = 15;
+    std::vector<uint8_t> table; // Depth rows of `width` counters
+    size_t width;
+    size_t additions = 0;
+    size_t sampleSize; // Additions between halvings
+
+    size_t slot(size_t hash, int row) const;
+
+public:
+    explicit FrequencySketch(size_t capacity);
+    void increment(size_t hash);
+    int estimate(size_t hash) const;
+};
+
+// Sharded LRU cache of serialized responses with TinyLFU admission.
+// Each entry remembers the catalog generation it was rendered at; a lookup at a
+// newer generation treats it as a miss and drops it, so ingest invalidates the
+// whole cache by bumping one counter instead of walking the shards.
+class QueryCache {
+public:
+    struct Stats {
+        uint64_t hits, misses, stale, insertions, evictions, rejections;
+        uint64_t entries;
+        double avgHitMicros, avgMissMicros; // Request time when served from / filled into the cache
+    };
+
+    QueryCache(size_t capacity, size_t shardCount = 16);
+
+    // Copies the cached value into `value` if it exists at this generation
+    bool get(const std::string& key, uint64_t generation, std::string& value);
+    // Inserts unless the shard is full and the key is less popular than the LRU victim.
+    // Entries older than `generation` are dropped to make room before any admission test.
+    void put(const std::string& key, uint64_t generation, std::string value);
+    void recordLatency(bool hit, std::chrono::nanoseconds elapsed);
+    Stats stats() const;
+
+private:
+    struct Entry {
+        std::string key;
+        uint64_t generation;
+        std::string value;
+    };
+    struct Shard {
+        std::mutex mutex;
+        std::list<Entry> lru; // Most recently used at the front
+        std::unordered_map<std::string, std::list<Entry>::iterator> map;
+        FrequencySketch sketch;
+        explicit Shard(size_t capacity) : sketch(capacity) {}
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    size_t shardCapacity;
+    std::atomic<uint64_t> hits{0}, misses{0}, stale{0}, insertions{0}, evictions{0}, rejections{0};
+    std::atomic<uint64_t> hitNanos{0}, missNanos{0}, timedHits{0}, timedMisses{0};
+
+    Shard& shardFor(size_t hash) { return *shards[hash % shards.size()]; }
+};
+
+#endif // QUERY_CACHE_H
@@ -0,0 +1,118 @@
+#ifndef RECOMMENDATIONS_H
+#define RECOMMENDATIONS_H
+
+#include "Candidate.h"
+#include "geo.h"
+#include "job.h"
+#include "job_json.h"
+#include "skill_embeddings.h"
+#include "sparse_scoring.h"
+#include "string_interner.h"
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Told, under the state's mutex, about every match appended after it subscribed. Runs
+// on the ingest path with the catalog locked, so implementations must only enqueue.
+class MatchListener {
+public:
+    virtual ~MatchListener() = default;
+    virtual void onMatch(const std::string& renderedMatch) = 0;
+};
+
+struct RecommendationMatch {
+    int jobId;
+    int matchedSkills;
+    int similarSkills; // Job skills matched only through SkillEmbeddings similarity
+    float skillScore;
+};
+
+// A match as rendered for clients: the job's fields plus how it matched
+template <class Writer>
+void writeMatch(Writer& out, const Job& job, const RecommendationMatch& match) {
+    out.beginObject();
+    writeJobFields(out, job, match.jobId);
+    out.key("matchedSkills");
+    out.integer(match.matchedSkills);
+    out.key("similarSkills");
+    out.integer(match.similarSkills);
+    out.key("skillScore");
+    out.number(std::round(match.skillScore * 100.0) / 100);
+    out.endObject();
+}
+
+// A candidate profile resolved against the catalog, plus the recommendations found so far.
+// Filled once from the skill matrix when the profile is stored, then kept current by
+// RecommendationSubscriptions as jobs are ingested, so a poll only reads `rendered`.
+struct RecommendationState {
+    std::mutex mutex; // Guards everything below once the state is subscribed
+
+    std::vector<uint32_t> skillIds;         // Interned lowercase skills, ascending
+    std::vector<std::string> pendingSkills; // Lowercased skills no job has required yet
+    std::vector<std::pair<uint32_t, float>> relatedSkills; // Similar skills and their similarity, ascending id
+    LocationPreference where;               // Preferred location and the gazetteer places in its radius
+    double minSalary = 0;
+
+    size_t jobsSeen = 0;                      // Jobs below this id have been matched
+    std::vector<RecommendationMatch> matches; // Ascending job id
+    std::string rendered;                     // Comma-separated JSON of `matches`
+    std::vector<std::weak_ptr<MatchListener>> listeners;
+
+    // Told, under the mutex, when appending a match changes recommendationBytes(); ingest calls it
+    // with the catalog locked, so it must only re-account (the session store's resize)
+    std::function<void(size_t bytes)> onResize;
+    size_t reportedBytes = 0; // recommendationBytes() as last passed to onResize
+};
+
+struct RecommendationDelta {
+    size_t firstNew = 0; // Index into matches of the first match found by this update
+    size_t postingsTouched = 0;
+    size_t jobsScored = 0;
+};
+
+// Resolves the profile's skills and location to interned ids and gazetteer places, and looks up
+// the skills similar to them; the caller holds the catalog lock
+std::shared_ptr<RecommendationState> resolveProfile(const Candidate& candidate, const StringInterner& skillNames,
+                                                    const StringInterner& locationNames, const SkillEmbeddings& embeddings,
+                                                    const Gazetteer& gazetteer);
+// Matches and renders jobs[jobsSeen..] as one row of the sparse product with the skill matrix; the caller holds the catalog lock and state.mutex.
+// Skills and a location no job had used before are resolved first, so a job introducing them still matches.
+RecommendationDelta extendRecommendations(RecommendationState& state, const std::vector<Job>& jobs, const SkillMatrix& matrix,
+                                          const StringInterner& skillNames, const StringInterner& locationNames);
+// Approximate heap footprint, for the session store's memory limit
+size_t recommendationBytes(const RecommendationState& state);
+
+// Reverse index from skill to the profiles requiring it or a similar skill. An ingested job is
+// offered only to the profiles sharing one of its skills, and appended to those whose location and
+// salary also match. Subscribers are held weakly: a replaced or expired session drops out
+// on its own and its entries are pruned lazily.
+class RecommendationSubscriptions {
+public:
+    // Registers a state filled up to the current catalog; the caller holds the catalog lock (shared suffices)
+    void subscribe(const std::shared_ptr<RecommendationState>& state);
+    // Offers jobs[jobId], just appended, to its subscribers; the caller holds the catalog lock exclusively
+    void publish(const std::vector<Job>& jobs, int jobId, const StringInterner& skillNames, const StringInterner& locationNames);
+    size_t subscriptionCount() const;
+
+private:
+    using Subscribers = std::vector<std::weak_ptr<RecommendationState>>;
+
+    mutable std::mutex mutex; // Concurrent subscribes from profile updates
+    std::vector<Subscribers> bySkill;                    // Skill id -> subscribers
+    std::unordered_map<std::string, Subscribers> pending; // Lowercased skill not yet interned -> subscribers
+    size_t prunePendingAt = 64;
+
+    // Drops names whose subscribers have all lapsed; names no job ever uses are never promoted
+    void prunePending();
+
+    static void add(Subscribers& subscribers, const std::shared_ptr<RecommendationState>& state);
+    // Moves subscribers waiting on a skill that was just interned to its id
+    void promotePending(uint32_t skillId, const std::string& name);
+};
+
+#endif // RECOMMENDATIONS_H
@@ -0,0 +1,76 @@
+#ifndef SESSION_STORE_H
+#define SESSION_STORE_H
+
+#include "Candidate.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Candidate profiles keyed by client-chosen session id, safe to share between
+// request threads. Sessions are split over independently locked shards, each an
+// LRU list plus hash map, so a lookup or touch is O(1) under one shard's lock.
+// A session idle for longer than the TTL is gone, and when the approximate
+// footprint of all sessions exceeds the byte limit the least recently used
+// sessions, across all shards, are evicted until it fits again.
+class SessionStore {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Stats {
+        uint64_t sessions, bytes;
+        uint64_t expirations, evictions;
+    };
+
+    SessionStore(size_t maxBytes, std::chrono::seconds idleTtl, size_t shardCount = 16);
+
+    // Creates or replaces the session's profile and marks it most recently used. derivedBytes is
+    // the footprint of what the profile owns beyond sessionBytes(), i.e. its recommendations.
+    void put(const std::string& sessionId, Candidate candidate, size_t derivedBytes = 0);
+    // The session's profile, touched; null if unknown or expired. Profiles are
+    // immutable once stored, so the pointer stays valid after a concurrent put.
+    std::shared_ptr<const Candidate> get(const std::string& sessionId);
+    // Re-accounts a session whose recommendations grew or shrank after put, evicting if now over
+    // the limit; ignored unless the session still holds `recommendations` (not replaced or dropped)
+    void resize(const std::string& sessionId, const RecommendationState* recommendations, size_t derivedBytes);
+    Stats stats() const;
+
+private:
+    struct Entry {
+        std::string sessionId;
+        std::shared_ptr<const Candidate> candidate;
+        Clock::time_point lastAccess;
+        size_t bytes; // sessionBytes() plus the derived bytes
+    };
+    struct Shard {
+        std::mutex mutex;
+        std::list<Entry> lru; // Most recently used at the front
+        std::unordered_map<std::string, std::list<Entry>::iterator> map;
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    size_t maxBytes;
+    Clock::duration idleTtl;
+    std::atomic<uint64_t> totalBytes{0}, expirations{0}, evictions{0};
+    std::atomic<size_t> sweepCursor{0};
+
+    Shard& shardFor(const std::string& sessionId) { return *shards[std::hash<std::string>{}(sessionId) % shards.size()]; }
+    void remove(Shard& shard, std::list<Entry>::iterator it);
+    // Drops idle sessions from the shard's LRU tail; the caller holds the shard lock
+    void expire(Shard& shard, Clock::time_point now);
+    // Expires one more shard per call, round-robin, so shards nobody touches still age out
+    void sweepNext(Clock::time_point now);
+    // Evicts the least recently used session of any shard while over the limit, sparing the held
+    // shard's most recent one if keepNewest; the caller holds that shard's lock
+    void enforceLimit(Shard& held, bool keepNewest);
+};
+
+// Approximate heap footprint of a stored session, including container overhead
+size_t sessionBytes(const std::string& sessionId, const Candidate& candidate);
+
+#endif // SESSION_STORE_H
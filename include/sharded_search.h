@@ -0,0 +1,58 @@
+#ifndef SHARDED_SEARCH_H
+#define SHARDED_SEARCH_H
+
+#include "job.h"
+#include "ngram_index.h"
+#include "thread_pool.h"
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+using ScorePair = std::pair<int, int>; // <score, jobIndex>
+
+struct SearchResult {
+    std::vector<ScorePair> top; // Highest score first, lower job id first on ties
+    std::vector<int> matched;   // Every job that scored above 0, when requested (unordered)
+    size_t postingsTouched = 0; // Trigram posting entries walked across all shards
+    size_t scored = 0;          // Candidate jobs passed to the scorer
+};
+
+// The catalog split round-robin by job id into shards, each with its own trigram
+// index. A query fans out to the shards on a dedicated pool (the calling thread
+// takes one shard itself), each shard keeps its own top-K heap, and the per-shard
+// heaps are merged. Ranking is deterministic, so results do not depend on the shard count.
+class ShardedSearch {
+public:
+    using Scorer = std::function<int(const Job&)>;
+
+    // Catalogs smaller than this are searched on the calling thread; fan-out costs more than it saves
+    static constexpr size_t ParallelThreshold = 20000;
+
+    explicit ShardedSearch(size_t shardCount);
+
+    // Jobs must be added in increasing id order
+    void addJob(int jobId, const Job& job);
+
+    // Top K of the jobs whose title or skills may contain any of `terms`, scored by `score`
+    SearchResult search(const std::vector<Job>& jobs, const std::vector<std::string>& terms, size_t K,
+                        const Scorer& score, bool collectMatched) const;
+
+    size_t shardCount() const { return shards.size(); }
+    size_t trigramCount() const;
+
+private:
+    struct Shard {
+        std::vector<int> jobIds; // Shard-local id -> global job id
+        NgramIndex index;        // Over shard-local ids
+    };
+
+    std::vector<Shard> shards;
+    mutable ThreadPool pool;
+    size_t jobCount = 0;
+
+    static SearchResult searchShard(const Shard& shard, const std::vector<Job>& jobs, const std::vector<std::string>& terms,
+                                    size_t K, const Scorer& score, bool collectMatched);
+};
+
+#endif // SHARDED_SEARCH_H
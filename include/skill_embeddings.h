@@ -0,0 +1,113 @@
+#ifndef SKILL_EMBEDDINGS_H
+#define SKILL_EMBEDDINGS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <xmmintrin.h>
+#endif
+
+// Dot product of two float vectors, vectorized with SSE/AVX where the target has it;
+// inline because the graph and similarity scans call it millions of times per second
+inline float dotProduct(const float* a, const float* b, size_t n) {
+    size_t i = 0;
+    float sum = 0;
+#if defined(__AVX__)
+    __m256 acc = _mm256_setzero_ps();
+    for (size_t end = n / 8 * 8; i < end; i += 8) acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+    __m128 half = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    float lanes[4];
+    _mm_storeu_ps(lanes, half);
+    sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#elif defined(__SSE2__)
+    __m128 acc = _mm_setzero_ps();
+    for (size_t end = n / 4 * 4; i < end; i += 4) acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    float lanes[4];
+    _mm_storeu_ps(lanes, acc);
+    sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+    for (; i < n; ++i) sum += a[i] * b[i];
+    return sum;
+}
+
+// Dense vectors for interned skills, learned from which skills the catalog's jobs list together.
+// Two skills that appear alongside the same other skills ("react" and "reactjs" both next to
+// "javascript" and "redux") end up close even if no job lists both. Vectors are the rows of the
+// positive PMI co-occurrence matrix projected onto its top Dim-dimensional subspace (found by
+// subspace iteration, warm-started from the previous build) and unit-normalized, so similarity
+// is a single dot product.
+// A rebuild runs in three steps so the expensive middle one needs no lock: snapshot() copies the
+// PMI matrix out of the counts (a reader), build() iterates on the copy, and install() swaps the
+// result in (a writer). rebuild() runs all three in place.
+class SkillEmbeddings {
+public:
+    static constexpr size_t Dim = 32;
+    static constexpr float MinSimilarity = 0.9f;   // Cosine needed to count as a similar skill
+    static constexpr size_t MaxRelatedPerSkill = 3; // Bounds the extra matching work per profile skill
+    static constexpr uint32_t MinJobs = 5;          // Rarer skills have too little context to embed
+
+    // Positive PMI between skills with enough jobs as a sparse symmetric matrix, and the last
+    // build's basis to warm-start from
+    struct Snapshot {
+        size_t jobCount = 0;
+        size_t skills = 0;
+        std::vector<size_t> offsets{0}; // Row a spans [offsets[a], offsets[a + 1])
+        std::vector<uint32_t> columns;
+        std::vector<float> values;
+        std::vector<float> basis;
+    };
+    struct Build {
+        size_t jobCount = 0; // Jobs counted when the snapshot was taken
+        std::vector<float> basis;
+        std::vector<float> vectors;
+        std::vector<uint8_t> present;
+    };
+
+    // Counts the co-occurrences of a job's ascending, unique skill ids
+    void addJob(const std::vector<uint32_t>& skillIds);
+    // Whether the catalog has grown by a quarter since the last installed build
+    bool rebuildDue() const;
+    Snapshot snapshot() const;
+    static Build build(Snapshot snapshot);
+    void install(Build next);
+    void rebuild() { install(build(snapshot())); }
+
+    size_t skillCount() const { return vectors.size() / Dim; }
+    size_t version() const { return builds; } // Bumped by every rebuild
+    // Nullptr if the skill has no vector yet (new since the last build, or too rare)
+    const float* vector(uint32_t skillId) const;
+    float similarity(uint32_t a, uint32_t b) const;
+    // Up to `limit` other skills at least minSimilarity away from skillId, most similar first
+    std::vector<std::pair<uint32_t, float>> nearest(uint32_t skillId, size_t limit, float minSimilarity = MinSimilarity) const;
+    // Skills similar to any of `skillIds` (ascending) but not among them, ascending by id,
+    // each with its best similarity; at most MaxRelatedPerSkill per input skill
+    std::vector<std::pair<uint32_t, float>> related(const std::vector<uint32_t>& skillIds) const;
+
+private:
+    std::vector<std::unordered_map<uint32_t, uint32_t>> cooccurrences; // Skill -> other skill -> jobs listing both
+    std::vector<uint32_t> jobsWithSkill;
+    size_t jobCount = 0;
+    size_t builtAt = 0; // jobCount at the last rebuild
+    size_t builds = 0;
+
+    std::vector<float> basis;     // Skills x Dim, orthonormal columns spanning the embedded subspace
+    std::vector<float> vectors;   // skillCount() x Dim, row-major
+    std::vector<uint8_t> present; // Whether the skill's row is a real vector
+};
+
+// How a job's skills overlap a profile: exact matches, similar-skill matches, and the sum of
+// 1 per exact match plus the similarity of each similar match
+struct SkillOverlap {
+    int exact = 0;
+    int similar = 0;
+    float score = 0;
+};
+SkillOverlap skillOverlap(const std::vector<uint32_t>& jobSkills, const std::vector<uint32_t>& skillIds,
+                          const std::vector<std::pair<uint32_t, float>>& related);
+
+#endif // SKILL_EMBEDDINGS_H
@@ -0,0 +1,83 @@
+#ifndef SLOW_QUERY_LOG_H
+#define SLOW_QUERY_LOG_H
+
+#include "bounded_queue.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+
+// What one search or recommendation request did, filled in by the handler as it goes.
+// Phase marks are one clock read each, so every request carries a plan and only the
+// slow ones pay for formatting.
+class QueryPlan {
+public:
+    struct Phase {
+        const char* name; // String literal
+        uint64_t micros;
+    };
+    static constexpr size_t MaxPhases = 8;
+
+    std::string route;
+    std::string query;          // Normalized; filled in only once the request is known to be slow
+    size_t candidateSkills = 0; // Skills on the profile (recommendations) or skill filters (search)
+    size_t postingsTouched = 0; // Posting list entries walked to find candidate jobs
+    size_t jobsScored = 0;
+    size_t results = 0;
+    Phase phases[MaxPhases];
+    size_t phaseCount = 0;
+    uint64_t totalMicros = 0;
+
+    explicit QueryPlan(const char* route = "");
+
+    // Ends the phase that started at the previous mark (or at construction)
+    void endPhase(const char* name);
+    // Stamps totalMicros and returns it
+    uint64_t finish();
+
+private:
+    std::chrono::steady_clock::time_point started;
+    std::chrono::steady_clock::time_point lastMark;
+};
+
+// Writes plans of requests slower than a threshold as JSON lines. Request threads
+// only push onto a lock-free ring; a background thread formats and writes, so a slow
+// disk never adds to request latency. When the ring is full the plan is dropped and counted.
+class SlowQueryLog {
+public:
+    // Empty path logs to stderr
+    SlowQueryLog(uint64_t thresholdMicros, const std::string& path = "", size_t queueCapacity = 1024);
+    ~SlowQueryLog(); // Writes whatever is still queued, then joins
+
+    bool isSlow(uint64_t micros) const { return micros >= thresholdMicros; }
+    void submit(QueryPlan plan);
+
+    uint64_t threshold() const { return thresholdMicros; }
+    uint64_t logged() const { return loggedCount.load(std::memory_order_relaxed); }
+    uint64_t dropped() const { return droppedCount.load(std::memory_order_relaxed); }
+    // The most recent logged entries as a JSON array string, oldest first
+    std::string recentJson() const;
+
+private:
+    static constexpr size_t RecentLimit = 100;
+
+    uint64_t thresholdMicros;
+    std::ofstream file;
+    std::ostream* out;
+    BoundedQueue<QueryPlan> queue;
+    std::atomic<bool> stopping{false};
+    std::atomic<uint64_t> loggedCount{0};
+    std::atomic<uint64_t> droppedCount{0};
+    mutable std::mutex recentMutex; // Writer thread vs. readers of recentJson
+    std::deque<std::string> recent;
+    std::thread writer;
+
+    void writerLoop();
+};
+
+#endif // SLOW_QUERY_LOG_H
@@ -0,0 +1,52 @@
+#ifndef SPARSE_SCORING_H
+#define SPARSE_SCORING_H
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// The 0/1 job x skill incidence matrix, stored by job (CSR) and by skill (CSC).
+// Scoring candidates against jobs is the sparse product (candidate x skill) * (skill x job),
+// whose entries are shared-skill counts. The CSC side covers a frozen prefix of the jobs in
+// flat arrays; jobs ingested since then sit in small per-skill delta columns and are folded
+// in once they grow past a fraction of the frozen part, so ingest stays amortized O(row).
+class SkillMatrix {
+public:
+    // Jobs per accumulator tile: 8192 32-bit counters stay resident in L1/L2
+    static constexpr size_t JobBlock = 8192;
+    // Rows scored against one job tile before moving on, so the column segments they share stay cached
+    static constexpr size_t RowBlock = 32;
+
+    using Emit = std::function<void(size_t row, int jobId, uint32_t score)>;
+
+    // Appends the next job (id = jobCount()) with its ascending, unique skill ids
+    void addJob(const std::vector<uint32_t>& skillIds);
+
+    size_t jobCount() const { return rowOffsets.size() - 1; }
+    size_t nonZeros() const { return rowSkills.size(); }
+    // Skill ids of a job, ascending
+    std::pair<const uint32_t*, const uint32_t*> jobSkills(int jobId) const {
+        return {rowSkills.data() + rowOffsets[jobId], rowSkills.data() + rowOffsets[jobId + 1]};
+    }
+
+    // Multiplies `rows` (each a set of unique skill ids, e.g. one per candidate) by the matrix
+    // restricted to jobs >= firstJob, calling emit(row, job, shared skills) for every nonzero,
+    // in ascending job order within each row. With `weights` (parallel to rows), a shared skill
+    // adds its weight instead of 1; sums must fit in 32 bits. Returns the column entries visited.
+    size_t multiply(const std::vector<std::vector<uint32_t>>& rows, size_t firstJob, const Emit& emit,
+                    const std::vector<std::vector<uint32_t>>* weights = nullptr) const;
+
+private:
+    std::vector<uint32_t> rowOffsets{0}; // CSR
+    std::vector<uint32_t> rowSkills;
+    std::vector<uint32_t> colOffsets{0}; // CSC over jobs [0, frozenJobs)
+    std::vector<int> colJobs;
+    size_t frozenJobs = 0;
+    std::vector<std::vector<int>> deltaColumns; // Skill -> ascending jobs >= frozenJobs
+    size_t deltaNonZeros = 0;
+
+    void compact(); // Folds the delta columns into the CSC arrays
+};
+
+#endif // SPARSE_SCORING_H
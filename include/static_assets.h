@@ -0,0 +1,45 @@
+#ifndef STATIC_ASSETS_H
+#define STATIC_ASSETS_H
+
+#include "compression.h"
+#include <ctime>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// A file read once at startup, with its precompressed forms and cache validators
+struct StaticAsset {
+    std::string contentType;
+    std::string body;
+    std::string gzip;    // Empty if compressing does not pay off
+    std::string deflate;
+    std::string etag;    // Weak, over the uncompressed body, so it holds across encodings
+    std::string lastModified; // HTTP-date
+    std::time_t modified = 0;
+
+    // The body for a negotiated encoding; `encoding` falls back to Identity without a compressed form
+    const std::string& bodyFor(ContentEncoding& encoding) const;
+};
+
+// The files under a directory, keyed by their path relative to it ("index.html", "css/app.css")
+class StaticAssets {
+public:
+    // Loads and precompresses every regular file under dir; returns the files loaded
+    size_t load(const std::string& dir);
+    const StaticAsset* find(const std::string& path) const;
+    size_t size() const { return assets.size(); }
+
+private:
+    std::unordered_map<std::string, StaticAsset> assets;
+};
+
+// True if an If-None-Match header lists etag or "*" (weak comparison: W/ prefixes are ignored)
+bool etagMatches(std::string_view ifNoneMatch, std::string_view etag);
+// True if the request's If-None-Match, or failing that If-Modified-Since, shows the client's copy is current
+bool notModified(const StaticAsset& asset, std::string_view ifNoneMatch, std::string_view ifModifiedSince);
+
+std::string httpDate(std::time_t time);
+// -1 if the date cannot be parsed
+std::time_t parseHttpDate(std::string_view date);
+
+#endif // STATIC_ASSETS_H
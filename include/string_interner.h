@@ -0,0 +1,26 @@
+#ifndef STRING_INTERNER_H
+#define STRING_INTERNER_H
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Maps strings to dense ids (0, 1, 2, ...) so per-value counters can be plain arrays.
+// Strings live in a deque, so the views used as map keys stay valid as it grows.
+class StringInterner {
+private:
+    std::deque<std::string> strings;
+    std::unordered_map<std::string_view, uint32_t> ids;
+
+public:
+    static constexpr uint32_t NotFound = UINT32_MAX;
+
+    uint32_t intern(std::string_view s);
+    uint32_t find(std::string_view s) const; // NotFound if never interned
+    const std::string& str(uint32_t id) const { return strings[id]; }
+    size_t size() const { return strings.size(); }
+};
+
+#endif // STRING_INTERNER_H
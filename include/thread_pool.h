@@ -0,0 +1,43 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads draining a FIFO task queue
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable ready;
+    bool stopping = false;
+
+    void workerLoop();
+
+public:
+    explicit ThreadPool(size_t threadCount);
+    ~ThreadPool(); // Finishes queued tasks, then joins
+
+    size_t size() const { return workers.size(); }
+
+    template <typename F>
+    auto submit(F f) -> std::future<decltype(f())> {
+        auto task = std::make_shared<std::packaged_task<decltype(f())()>>(std::move(f));
+        std::future<decltype(f())> result = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.emplace([task]() { (*task)(); });
+        }
+        ready.notify_one();
+        return result;
+    }
+};
+
+#endif // THREAD_POOL_H
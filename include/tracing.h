@@ -0,0 +1,47 @@
+#ifndef TRACING_H
+#define TRACING_H
+
+#include <cstdint>
+#include <string>
+
+// Lightweight spans for hot-path phases, compiled in only with -DJOB_PORTAL_TRACING
+// (`make TRACING=1`). Each thread appends finished spans to its own ring buffer, so
+// recording never contends with other request threads; the newest spans of every
+// thread can be dumped as Chrome trace-event JSON (chrome://tracing, Perfetto).
+//
+//   TRACE_SPAN("search.score"); // Times the rest of the enclosing scope
+//
+// Span names must be string literals: only the pointer is stored.
+
+#ifdef JOB_PORTAL_TRACING
+constexpr bool tracingEnabled = true;
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SPAN(name) TraceSpan TRACE_CONCAT(traceSpan_, __LINE__)(name)
+#else
+constexpr bool tracingEnabled = false;
+#define TRACE_SPAN(name) do {} while (0)
+#endif
+
+// Spans kept per thread; older ones are overwritten
+constexpr size_t TraceBufferCapacity = 16384;
+
+uint64_t traceNowNs();
+void recordTraceEvent(const char* name, uint64_t startNs, uint64_t durationNs);
+// {"traceEvents": [...]} with one complete ("X") event per recorded span
+std::string dumpChromeTrace();
+void clearTraceEvents();
+
+class TraceSpan {
+private:
+    const char* name;
+    uint64_t startNs;
+
+public:
+    explicit TraceSpan(const char* name) : name(name), startNs(traceNowNs()) {}
+    ~TraceSpan() { recordTraceEvent(name, startNs, traceNowNs() - startNs); }
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+};
+
+#endif // TRACING_H
@@ -0,0 +1,113 @@
+#ifndef WIRE_FORMAT_H
+#define WIRE_FORMAT_H
+
+#include "json_writer.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Response encodings an API client can ask for with its Accept header
+enum class WireFormat { Json, MsgPack, Cbor };
+
+// The acceptable format with the highest q-value, earliest listed on ties; JSON if none is named
+WireFormat negotiateFormat(std::string_view accept);
+const char* formatName(WireFormat format);     // "json", "msgpack", "cbor"
+const char* contentTypeFor(WireFormat format);
+
+// MessagePack with JsonWriter's interface. Container sizes are not known up front, so each
+// container gets a 32-bit size slot that is patched, and shrunk to the fix/16-bit form, on close.
+class MsgPackWriter {
+public:
+    explicit MsgPackWriter(std::string& out) : out(out) {}
+
+    void beginObject() { open(true); }
+    void endObject() { close(0x80, 0xde, 0xdf); }
+    void beginArray() { open(false); }
+    void endArray() { close(0x90, 0xdc, 0xdd); }
+    void key(std::string_view name) {
+        ++containers.back().count;
+        appendString(name);
+    }
+
+    void string(std::string_view value) {
+        countValue();
+        appendString(value);
+    }
+    void number(double value);  // float32 when that is exact, else float64
+    void integer(int64_t value);
+    void boolean(bool value) {
+        countValue();
+        out += char(value ? 0xc3 : 0xc2);
+    }
+    void null() {
+        countValue();
+        out += char(0xc0);
+    }
+
+private:
+    struct Container {
+        size_t offset; // Of the size slot
+        uint32_t count;
+        bool map;
+    };
+    std::string& out;
+    std::vector<Container> containers;
+
+    void countValue() {
+        if (!containers.empty() && !containers.back().map) ++containers.back().count;
+    }
+    void open(bool map);
+    void close(uint8_t fix, uint8_t size16, uint8_t size32);
+    void appendString(std::string_view value);
+};
+
+// CBOR with JsonWriter's interface; objects and arrays are written with indefinite lengths
+class CborWriter {
+public:
+    explicit CborWriter(std::string& out) : out(out) {}
+
+    void beginObject() { out += char(0xbf); }
+    void endObject() { out += char(0xff); }
+    void beginArray() { out += char(0x9f); }
+    void endArray() { out += char(0xff); }
+    void key(std::string_view name) { string(name); }
+
+    void string(std::string_view value) {
+        head(3, value.size());
+        out += value;
+    }
+    void number(double value); // float32 when that is exact, else float64
+    void integer(int64_t value) {
+        if (value >= 0) head(0, value);
+        else head(1, -1 - value);
+    }
+    void boolean(bool value) { out += char(value ? 0xf5 : 0xf4); }
+    void null() { out += char(0xf6); }
+
+private:
+    std::string& out;
+
+    void head(uint8_t major, uint64_t argument);
+};
+
+// Renders `render(writer)` in the given format into a string reserved to `reserve` bytes;
+// `render` is generic over the writer type
+template <class Render>
+std::string renderAs(WireFormat format, size_t reserve, Render render) {
+    std::string body;
+    body.reserve(reserve);
+    if (format == WireFormat::MsgPack) {
+        MsgPackWriter out(body);
+        render(out);
+    } else if (format == WireFormat::Cbor) {
+        CborWriter out(body);
+        render(out);
+    } else {
+        JsonWriter out(body);
+        render(out);
+    }
+    return body;
+}
+
+#endif // WIRE_FORMAT_H
@@ -0,0 +1,65 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include "Candidate.h"
+#include "job.h"
+#include <random>
+#include <string>
+#include <vector>
+
+// Zipf(s) over ranks 0..n-1, sampled by binary search over the cumulative weights
+class ZipfDistribution {
+private:
+    std::vector<double> cdf;
+
+public:
+    ZipfDistribution() = default;
+    ZipfDistribution(size_t n, double s);
+    size_t size() const { return cdf.size(); }
+    size_t operator()(std::mt19937_64& rng) const;
+};
+
+struct WorkloadConfig {
+    unsigned long seed = 42;
+    size_t companies = 2000;
+    double skillSkew = 1.1;    // Zipf exponents: higher means a few values dominate
+    double locationSkew = 1.0;
+    double companySkew = 1.2;
+    double querySkew = 1.2;
+    double typoRate = 0.05;    // Share of search queries with one injected typo
+};
+
+// One request from a query log
+struct WorkloadQuery {
+    std::string kind;  // "search", "autocomplete" or "recommend"
+    std::string value; // Keyword, title prefix or sessionId
+};
+
+// Deterministic generator of jobs, candidate profiles and a matching query log.
+// Skills, locations, companies and queries follow Zipf distributions; each role has a
+// core skill set so skills co-occur the way real postings do, and salaries are
+// log-normal, scaled by seniority.
+class WorkloadGenerator {
+public:
+    explicit WorkloadGenerator(const WorkloadConfig& config = WorkloadConfig());
+
+    Job nextJob();
+    Candidate nextCandidate();
+    // Session ids are "session-<n>" for n below candidateCount, Zipf-skewed towards low n
+    WorkloadQuery nextQuery(size_t candidateCount);
+
+private:
+    WorkloadConfig config;
+    std::mt19937_64 rng;
+    ZipfDistribution skillPick, locationPick, companyPick, rolePick, searchPick, sessionPick;
+    std::vector<std::string> companyNames;
+    std::vector<std::string> searchVocabulary;
+
+    std::vector<std::string> pickSkills(size_t role, int count);
+    std::string misspell(std::string word);
+};
+
+// Convenience for benchmarks: n jobs from a default-configured generator
+std::vector<Job> generateJobs(size_t n, unsigned long seed = 42);
+
+#endif // WORKLOAD_H
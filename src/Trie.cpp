@@ -1,4 +1,5 @@
 #include "include/Trie.h"
+#include <algorithm>
 
 Trie::Trie() {
     root = new TrieNode();
@@ -21,6 +22,7 @@ void Trie::insert(const std::string& word) {
     for (char ch : word) {
         if (current->children.find(ch) == current->children.end()) {
             current->children[ch] = new TrieNode();
+            nodes++;
         }
         current = current->children[ch];
     }
@@ -52,3 +54,32 @@ void Trie::collectWords(TrieNode* node, std::string& currentPrefix, std::vector<
         currentPrefix.pop_back(); // Backtrack
     }
 }
+
+std::vector<FuzzyMatch> Trie::searchFuzzy(const std::string& word, int maxEdits) const {
+    std::vector<FuzzyMatch> results;
+    LevenshteinAutomaton automaton(word, maxEdits);
+    std::vector<LevenshteinAutomaton::State> rows{automaton.start()}; // One row per depth, reused across branches
+    std::string currentWord;
+    collectFuzzy(root, automaton, rows, currentWord, results);
+
+    std::sort(results.begin(), results.end(), [](const FuzzyMatch& a, const FuzzyMatch& b) {
+        return a.distance != b.distance ? a.distance < b.distance : a.term < b.term;
+    });
+    return results;
+}
+
+void Trie::collectFuzzy(TrieNode* node, const LevenshteinAutomaton& automaton, std::vector<LevenshteinAutomaton::State>& rows,
+                        std::string& currentWord, std::vector<FuzzyMatch>& results) const {
+    size_t depth = currentWord.size();
+    if (node->isEndOfWord && automaton.isMatch(rows[depth])) {
+        results.push_back({currentWord, automaton.distance(rows[depth])});
+    }
+    if (rows.size() < depth + 2) rows.emplace_back();
+    for (auto const& [key, val] : node->children) {
+        automaton.step(rows[depth], key, rows[depth + 1]);
+        if (!automaton.canMatch(rows[depth + 1])) continue; // Prune: no completion can get back under budget
+        currentWord.push_back(key);
+        collectFuzzy(val, automaton, rows, currentWord, results);
+        currentWord.pop_back(); // Backtrack
+    }
+}
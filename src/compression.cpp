@@ -0,0 +1,76 @@
+#include "compression.h"
+#include <cstdlib>
+#include <stdexcept>
+#include <strings.h>
+#include <zlib.h>
+
+namespace {
+
+std::string_view trim(std::string_view s) {
+    size_t begin = s.find_first_not_of(" \t");
+    if (begin == std::string_view::npos) return {};
+    return s.substr(begin, s.find_last_not_of(" \t") - begin + 1);
+}
+
+bool equalsIgnoreCase(std::string_view a, const char* b) {
+    return a.size() == std::char_traits<char>::length(b) && strncasecmp(a.data(), b, a.size()) == 0;
+}
+
+} // namespace
+
+ContentEncoding negotiateEncoding(std::string_view acceptEncoding) {
+    // -1 until listed; an explicit entry beats the wildcard
+    double gzip = -1, deflate = -1, wildcard = -1;
+    while (!acceptEncoding.empty()) {
+        size_t comma = acceptEncoding.find(',');
+        std::string_view entry = acceptEncoding.substr(0, comma);
+        acceptEncoding = comma == std::string_view::npos ? std::string_view() : acceptEncoding.substr(comma + 1);
+
+        size_t semicolon = entry.find(';');
+        std::string_view coding = trim(entry.substr(0, semicolon));
+        double q = 1;
+        if (semicolon != std::string_view::npos) {
+            std::string_view param = trim(entry.substr(semicolon + 1));
+            if (param.size() > 2 && (param[0] == 'q' || param[0] == 'Q') && param[1] == '=') {
+                q = std::strtod(std::string(param.substr(2)).c_str(), nullptr);
+            }
+        }
+        if (equalsIgnoreCase(coding, "gzip") || equalsIgnoreCase(coding, "x-gzip")) gzip = q;
+        else if (equalsIgnoreCase(coding, "deflate")) deflate = q;
+        else if (coding == "*") wildcard = q;
+    }
+    if (gzip < 0) gzip = wildcard;
+    if (deflate < 0) deflate = wildcard;
+    if (gzip > 0 && gzip >= deflate) return ContentEncoding::Gzip;
+    if (deflate > 0) return ContentEncoding::Deflate;
+    return ContentEncoding::Identity;
+}
+
+const char* encodingName(ContentEncoding encoding) {
+    switch (encoding) {
+    case ContentEncoding::Gzip: return "gzip";
+    case ContentEncoding::Deflate: return "deflate";
+    default: return "identity";
+    }
+}
+
+std::string compress(std::string_view data, ContentEncoding encoding, int level) {
+    if (encoding == ContentEncoding::Identity) return std::string(data);
+    z_stream stream{};
+    // windowBits 15 writes a zlib stream; +16 wraps it as gzip instead
+    int windowBits = encoding == ContentEncoding::Gzip ? 15 + 16 : 15;
+    if (deflateInit2(&stream, level, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        throw std::runtime_error("deflateInit2 failed");
+    }
+    // deflateBound covers the whole output, so one Z_FINISH call compresses everything
+    std::string out(deflateBound(&stream, data.size()), '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in = data.size();
+    stream.next_out = reinterpret_cast<Bytef*>(&out[0]);
+    stream.avail_out = out.size();
+    int status = deflate(&stream, Z_FINISH);
+    out.resize(stream.total_out);
+    deflateEnd(&stream);
+    if (status != Z_STREAM_END) throw std::runtime_error("deflate failed");
+    return out;
+}
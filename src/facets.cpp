@@ -0,0 +1,63 @@
+#include "facets.h"
+#include <algorithm>
+
+const std::vector<double>& salaryBucketEdges() {
+    static const std::vector<double> edges = {0, 10000, 25000, 50000, 75000, 100000, 150000, 200000};
+    return edges;
+}
+
+size_t salaryBucket(double salary) {
+    const auto& edges = salaryBucketEdges();
+    size_t bucket = std::upper_bound(edges.begin(), edges.end(), salary) - edges.begin();
+    return bucket == 0 ? 0 : bucket - 1; // Negative salaries land in the first bucket
+}
+
+namespace {
+
+// Counting array reused across queries on the same thread
+struct Counter {
+    std::vector<uint32_t> counts;
+    std::vector<uint32_t> touched;
+
+    void add(uint32_t id) {
+        if (counts[id]++ == 0) touched.push_back(id);
+    }
+
+    std::vector<FacetBucket> takeTop(size_t topN) {
+        std::vector<FacetBucket> buckets;
+        buckets.reserve(touched.size());
+        for (uint32_t id : touched) {
+            buckets.push_back({id, counts[id]});
+            counts[id] = 0;
+        }
+        touched.clear();
+        auto byCount = [](const FacetBucket& a, const FacetBucket& b) {
+            return a.count != b.count ? a.count > b.count : a.id < b.id;
+        };
+        size_t n = std::min(topN, buckets.size());
+        std::partial_sort(buckets.begin(), buckets.begin() + n, buckets.end(), byCount);
+        buckets.resize(n);
+        return buckets;
+    }
+};
+
+} // namespace
+
+Facets computeFacets(const std::vector<Job>& jobs, const std::vector<int>& matched,
+                     size_t skillCount, size_t locationCount, size_t topN) {
+    thread_local Counter skills, locations;
+    if (skills.counts.size() < skillCount) skills.counts.resize(skillCount);
+    if (locations.counts.size() < locationCount) locations.counts.resize(locationCount);
+
+    Facets facets;
+    facets.salaryHistogram.assign(salaryBucketEdges().size(), 0);
+    for (int jobId : matched) {
+        const Job& job = jobs[jobId];
+        for (uint32_t skillId : job.skillIds) skills.add(skillId);
+        locations.add(job.locationId);
+        facets.salaryHistogram[salaryBucket(job.salary)]++;
+    }
+    facets.skills = skills.takeTop(topN);
+    facets.locations = locations.takeTop(topN);
+    return facets;
+}
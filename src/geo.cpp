@@ -0,0 +1,119 @@
+#include "geo.h"
+#include "job_portal.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+static const double EarthRadiusKm = 6371.0;
+static const double KmPerDegree = EarthRadiusKm * M_PI / 180.0;
+
+double haversineKm(double lat1, double lon1, double lat2, double lon2) {
+    auto radians = [](double degrees) { return degrees * M_PI / 180.0; };
+    double dLat = radians(lat2 - lat1), dLon = radians(lon2 - lon1);
+    double a = std::sin(dLat / 2) * std::sin(dLat / 2) +
+               std::cos(radians(lat1)) * std::cos(radians(lat2)) * std::sin(dLon / 2) * std::sin(dLon / 2);
+    return 2 * EarthRadiusKm * std::asin(std::min(1.0, std::sqrt(a)));
+}
+
+uint32_t Gazetteer::add(const std::string& name, double lat, double lon, const std::vector<std::string>& aliases) {
+    uint32_t id = places.size();
+    places.push_back({name, lat, lon});
+    byName.emplace(toLower(name), id);
+    for (const auto& alias : aliases) byName.emplace(toLower(alias), id);
+    grid[cellKey(std::floor(lat / GridDegrees), std::floor(lon / GridDegrees))].push_back(id);
+    return id;
+}
+
+long Gazetteer::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) return -1;
+    long loaded = 0;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::vector<std::string> fields = split(line, '\t');
+        if (fields.size() < 3 || fields[0].empty()) continue;
+        char* end = nullptr;
+        double lat = std::strtod(fields[1].c_str(), &end);
+        if (*end) continue;
+        double lon = std::strtod(fields[2].c_str(), &end);
+        if (*end || std::abs(lat) > 90 || std::abs(lon) > 180) continue;
+        std::vector<std::string> aliases;
+        if (fields.size() > 3) {
+            for (const auto& alias : split(fields[3], ',')) {
+                if (!alias.empty()) aliases.push_back(alias);
+            }
+        }
+        add(fields[0], lat, lon, aliases);
+        loaded++;
+    }
+    return loaded;
+}
+
+uint32_t Gazetteer::resolve(std::string_view location) const {
+    auto trim = [](std::string_view s) {
+        size_t begin = s.find_first_not_of(" \t");
+        if (begin == std::string_view::npos) return std::string_view();
+        return s.substr(begin, s.find_last_not_of(" \t") - begin + 1);
+    };
+    std::string_view name = trim(location);
+    auto it = byName.find(toLower(std::string(name)));
+    if (it != byName.end()) return it->second;
+    size_t comma = name.find(',');
+    if (comma == std::string_view::npos) return NoPlace;
+    it = byName.find(toLower(std::string(trim(name.substr(0, comma)))));
+    return it != byName.end() ? it->second : NoPlace;
+}
+
+std::vector<uint32_t> Gazetteer::within(double lat, double lon, double radiusKm) const {
+    std::vector<uint32_t> found;
+    // Bounding box of the spherical cap in degrees. The cap's widest point is poleward of its
+    // centre, so the longitude half-width is asin(sin r / cos lat), not r / cos lat; a cap that
+    // reaches a pole spans every longitude.
+    double dLat = radiusKm / KmPerDegree;
+    double dLon = 180.0;
+    if (lat + dLat < 90.0 && lat - dLat > -90.0) {
+        double ratio = std::sin(radiusKm / EarthRadiusKm) / std::cos(lat * M_PI / 180.0);
+        if (ratio < 1.0) dLon = std::asin(ratio) * 180.0 / M_PI;
+    }
+    long rowBegin = std::floor(std::max(-90.0, lat - dLat) / GridDegrees), rowEnd = std::floor(std::min(90.0, lat + dLat) / GridDegrees);
+    long colBegin = std::floor((lon - dLon) / GridDegrees), colEnd = std::floor((lon + dLon) / GridDegrees);
+    long colsPerTurn = std::lround(360 / GridDegrees);
+    colEnd = std::min(colEnd, colBegin + colsPerTurn - 1); // A box wider than the globe visits each column once
+    for (long row = rowBegin; row <= rowEnd; ++row) {
+        for (long col = colBegin; col <= colEnd; ++col) {
+            // Wrap across the antimeridian into the stored column range [-180, 180)
+            long wrapped = ((col + colsPerTurn / 2) % colsPerTurn + colsPerTurn) % colsPerTurn - colsPerTurn / 2;
+            auto cell = grid.find(cellKey(row, wrapped));
+            if (cell == grid.end()) continue;
+            for (uint32_t id : cell->second) {
+                if (haversineKm(lat, lon, places[id].lat, places[id].lon) <= radiusKm) found.push_back(id);
+            }
+        }
+    }
+    std::sort(found.begin(), found.end());
+    found.erase(std::unique(found.begin(), found.end()), found.end());
+    return found;
+}
+
+std::vector<uint32_t> Gazetteer::within(uint32_t placeId, double radiusKm) const {
+    return within(places[placeId].lat, places[placeId].lon, radiusKm);
+}
+
+bool LocationPreference::accepts(const Job& job) const {
+    if (location.empty()) return true;
+    if (locationId != StringInterner::NotFound && job.locationId == locationId) return true;
+    return job.placeId != Gazetteer::NoPlace && std::binary_search(places.begin(), places.end(), job.placeId);
+}
+
+LocationPreference resolveLocationPreference(const std::string& location, double radiusKm, const StringInterner& locationNames,
+                                             const Gazetteer& gazetteer) {
+    LocationPreference preference;
+    preference.location = toLower(location);
+    if (preference.location.empty()) return preference;
+    preference.locationId = locationNames.find(preference.location);
+    uint32_t placeId = gazetteer.resolve(preference.location);
+    if (placeId != Gazetteer::NoPlace) preference.places = gazetteer.within(placeId, std::max(0.0, radiusKm));
+    return preference;
+}
@@ -0,0 +1,150 @@
+#include "hnsw_index.h"
+#include "skill_embeddings.h"
+#include <algorithm>
+#include <cmath>
+#include <queue>
+
+HnswIndex::HnswIndex(size_t dim, Params params)
+    : dim(dim), params(params), levelScale(1.0 / std::log((double)std::max<size_t>(2, params.M))), rng(params.seed) {}
+
+float HnswIndex::distance(const float* query, uint32_t id) const {
+    return 1.0f - dotProduct(query, vector(id), dim);
+}
+
+std::pair<const uint32_t*, const uint32_t*> HnswIndex::neighbours(uint32_t node, int layer) const {
+    if (layer == 0) {
+        const uint32_t* slot = &layer0[node * (1 + 2 * params.M)];
+        return {slot + 1, slot + 1 + slot[0]};
+    }
+    const std::vector<uint32_t>& ids = upperLinks[node][layer - 1];
+    return {ids.data(), ids.data() + ids.size()};
+}
+
+void HnswIndex::setNeighbours(uint32_t node, int layer, const std::vector<uint32_t>& ids) {
+    if (layer == 0) {
+        uint32_t* slot = &layer0[node * (1 + 2 * params.M)];
+        slot[0] = ids.size();
+        std::copy(ids.begin(), ids.end(), slot + 1);
+    } else {
+        upperLinks[node][layer - 1] = ids;
+    }
+}
+
+std::vector<HnswIndex::Scored> HnswIndex::searchLayer(const float* query, uint32_t entry, size_t ef, int layer) const {
+    // Visited marks are stamped with a per-search epoch, so they never need clearing
+    thread_local std::vector<uint32_t> visited;
+    thread_local uint32_t epoch = 0;
+    if (visited.size() < size()) visited.resize(size(), 0);
+    if (++epoch == 0) {
+        std::fill(visited.begin(), visited.end(), 0);
+        epoch = 1;
+    }
+
+    std::priority_queue<Scored, std::vector<Scored>, std::greater<Scored>> frontier; // Nearest on top
+    std::priority_queue<Scored> nearest;                                             // Farthest on top
+    float d = distance(query, entry);
+    frontier.push({d, entry});
+    nearest.push({d, entry});
+    visited[entry] = epoch;
+    while (!frontier.empty()) {
+        auto [dist, node] = frontier.top();
+        if (nearest.size() >= ef && dist > nearest.top().first) break;
+        frontier.pop();
+        auto [begin, end] = neighbours(node, layer);
+        for (const uint32_t* it = begin; it != end; ++it) {
+            uint32_t neighbour = *it;
+            if (visited[neighbour] == epoch) continue;
+            visited[neighbour] = epoch;
+            float dn = distance(query, neighbour);
+            if (nearest.size() < ef || dn < nearest.top().first) {
+                frontier.push({dn, neighbour});
+                nearest.push({dn, neighbour});
+                if (nearest.size() > ef) nearest.pop();
+            }
+        }
+    }
+    std::vector<Scored> found(nearest.size());
+    for (size_t i = found.size(); i-- > 0; nearest.pop()) found[i] = nearest.top();
+    return found;
+}
+
+std::vector<uint32_t> HnswIndex::selectNeighbors(const std::vector<Scored>& candidates, size_t m) const {
+    std::vector<uint32_t> kept, skipped;
+    for (const auto& [dist, id] : candidates) {
+        if (kept.size() >= m) break;
+        bool covered = false;
+        for (uint32_t other : kept) {
+            if (distance(vector(id), other) < dist) {
+                covered = true;
+                break;
+            }
+        }
+        (covered ? skipped : kept).push_back(id);
+    }
+    // Top up with the nearest skipped candidates so sparse regions keep their degree
+    for (size_t i = 0; kept.size() < m && i < skipped.size(); ++i) kept.push_back(skipped[i]);
+    return kept;
+}
+
+uint32_t HnswIndex::add(const float* v) {
+    uint32_t id = size();
+    data.insert(data.end(), v, v + dim);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    int level = (int)(-std::log(std::max(uniform(rng), 1e-12)) * levelScale);
+    levels.push_back(level);
+    layer0.resize(size() * (1 + 2 * params.M), 0);
+    upperLinks.emplace_back(level);
+    if (maxLevel < 0) {
+        entryPoint = id;
+        maxLevel = level;
+        return id;
+    }
+
+    const float* query = vector(id);
+    uint32_t entry = entryPoint;
+    for (int layer = maxLevel; layer > level; --layer) entry = searchLayer(query, entry, 1, layer)[0].second;
+    for (int layer = std::min(level, maxLevel); layer >= 0; --layer) {
+        std::vector<Scored> found = searchLayer(query, entry, params.efConstruction, layer);
+        size_t maxLinks = layer == 0 ? 2 * params.M : params.M;
+        std::vector<uint32_t> selected = selectNeighbors(found, params.M);
+        setNeighbours(id, layer, selected);
+        for (uint32_t neighbour : selected) {
+            auto [begin, end] = neighbours(neighbour, layer);
+            std::vector<uint32_t> back(begin, end);
+            back.push_back(id);
+            if (back.size() > maxLinks) {
+                std::vector<Scored> candidates;
+                for (uint32_t other : back) candidates.push_back({distance(vector(neighbour), other), other});
+                std::sort(candidates.begin(), candidates.end());
+                back = selectNeighbors(candidates, maxLinks);
+            }
+            setNeighbours(neighbour, layer, back);
+        }
+        entry = found[0].second;
+    }
+    if (level > maxLevel) {
+        maxLevel = level;
+        entryPoint = id;
+    }
+    return id;
+}
+
+std::vector<std::pair<uint32_t, float>> HnswIndex::search(const float* query, size_t k, size_t ef) const {
+    std::vector<std::pair<uint32_t, float>> results;
+    if (maxLevel < 0) return results;
+    uint32_t entry = entryPoint;
+    for (int layer = maxLevel; layer > 0; --layer) entry = searchLayer(query, entry, 1, layer)[0].second;
+    std::vector<Scored> found = searchLayer(query, entry, std::max(ef, k), 0);
+    for (size_t i = 0; i < found.size() && i < k; ++i) results.push_back({found[i].second, 1.0f - found[i].first});
+    return results;
+}
+
+std::vector<std::pair<uint32_t, float>> HnswIndex::exactSearch(const float* query, size_t k) const {
+    std::vector<Scored> all;
+    for (uint32_t id = 0; id < size(); ++id) all.push_back({distance(query, id), id});
+    size_t keep = std::min(k, all.size());
+    std::partial_sort(all.begin(), all.begin() + keep, all.end());
+    std::vector<std::pair<uint32_t, float>> results;
+    for (size_t i = 0; i < keep; ++i) results.push_back({all[i].second, 1.0f - all[i].first});
+    return results;
+}
@@ -0,0 +1,174 @@
+#include "job_json.h"
+#include <stdexcept>
+#include <variant>
+#include <vector>
+
+nlohmann::json jobToJson(const Job& job, int index) {
+    nlohmann::json j;
+    if (index >= 0) j["id"] = index;
+    j["title"] = job.title;
+    j["company"] = job.company;
+    j["location"] = job.location;
+    j["salary"] = job.salary;
+    j["skills"] = job.skills;
+    j["description"] = job.description;
+    return j;
+}
+
+Job jobFromJson(const nlohmann::json& body) {
+    Job job;
+    job.title = body["title"].get<std::string>();
+    job.company = body["company"].get<std::string>();
+    job.location = body["location"].get<std::string>();
+    job.salary = body["salary"].get<double>();
+    job.description = body.value("description", "");
+
+    for (const auto& skill : body["skills"]) {
+        job.skills.push_back(skill.get<std::string>());
+    }
+    return job;
+}
+
+namespace {
+
+// A top-level field of a flat request object and where its value goes
+struct Field {
+    const char* name;
+    std::variant<std::string*, double*, std::vector<std::string>*> target;
+    bool required;
+    bool seen = false;
+};
+
+// nlohmann SAX handler filling Fields from one JSON object. Values of unknown fields, however
+// nested, are skipped; duplicate keys keep the last value, as the DOM parser does.
+class FieldReader {
+public:
+    using json = nlohmann::json;
+
+    explicit FieldReader(std::vector<Field> fields) : fields(std::move(fields)) {}
+
+    void read(std::string_view text) {
+        if (!json::sax_parse(text.begin(), text.end(), this)) throw std::invalid_argument(error);
+        for (const auto& field : fields) {
+            if (field.required && !field.seen) throw std::invalid_argument(std::string("Missing field '") + field.name + "'");
+        }
+    }
+
+    bool null() { return unexpected(); }
+    bool boolean(bool) { return unexpected(); }
+    bool number_integer(json::number_integer_t value) { return number((double)value); }
+    bool number_unsigned(json::number_unsigned_t value) { return number((double)value); }
+    bool number_float(json::number_float_t value, const std::string&) { return number(value); }
+    bool binary(json::binary_t&) { return unexpected(); }
+
+    bool string(std::string& value) {
+        if (inStrings && depth == 2) {
+            std::get<std::vector<std::string>*>(current->target)->push_back(std::move(value));
+            return true;
+        }
+        if (!atField()) return depth > 0 || fail("Expected a JSON object");
+        if (auto target = std::get_if<std::string*>(&current->target)) {
+            **target = std::move(value);
+            current->seen = true;
+            return true;
+        }
+        return mismatch();
+    }
+
+    bool start_object(std::size_t) {
+        if (depth > 0 && (atField() || (inStrings && depth == 2))) return unexpected();
+        ++depth;
+        return true;
+    }
+    bool end_object() {
+        --depth;
+        return true;
+    }
+    bool key(std::string& name) {
+        if (depth != 1) return true;
+        current = nullptr;
+        for (auto& field : fields) {
+            if (name == field.name) current = &field;
+        }
+        return true;
+    }
+
+    bool start_array(std::size_t) {
+        if (depth == 0) return fail("Expected a JSON object");
+        if (inStrings && depth == 2) return unexpected();
+        if (atField()) {
+            auto target = std::get_if<std::vector<std::string>*>(&current->target);
+            if (!target) return mismatch();
+            (*target)->clear();
+            current->seen = true;
+            inStrings = true;
+        }
+        ++depth;
+        return true;
+    }
+    bool end_array() {
+        if (--depth == 1) inStrings = false;
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& e) { return fail(e.what()); }
+
+private:
+    std::vector<Field> fields;
+    Field* current = nullptr; // Field whose value comes next, if known; set by key() at depth 1
+    int depth = 0;            // Containers open
+    bool inStrings = false;   // Inside current's array of strings
+    std::string error;
+
+    bool atField() const { return depth == 1 && current; }
+
+    bool fail(std::string message) {
+        error = std::move(message);
+        return false;
+    }
+    bool mismatch() {
+        const char* expected = std::holds_alternative<std::string*>(current->target) ? "a string"
+                             : std::holds_alternative<double*>(current->target) ? "a number" : "an array of strings";
+        return fail(std::string("Field '") + current->name + "' must be " + expected);
+    }
+    // A value no field type accepts: an error only where a known field's value is expected
+    bool unexpected() {
+        if (depth == 0) return fail("Expected a JSON object");
+        if (inStrings && depth == 2) return fail(std::string("Field '") + current->name + "' must be an array of strings");
+        return atField() ? mismatch() : true;
+    }
+    bool number(double value) {
+        if (!atField() || inStrings) return unexpected();
+        if (auto target = std::get_if<double*>(&current->target)) {
+            **target = value;
+            current->seen = true;
+            return true;
+        }
+        return mismatch();
+    }
+};
+
+} // namespace
+
+Job jobFromJsonText(std::string_view text) {
+    Job job;
+    FieldReader({{"title", &job.title, true},
+                 {"company", &job.company, true},
+                 {"location", &job.location, true},
+                 {"salary", &job.salary, true},
+                 {"skills", &job.skills, true},
+                 {"description", &job.description, false}}).read(text);
+    return job;
+}
+
+Candidate candidateFromJsonText(std::string_view text, std::string& sessionId) {
+    Candidate candidate;
+    sessionId = "default";
+    FieldReader({{"sessionId", &sessionId, false},
+                 {"name", &candidate.name, true},
+                 {"location", &candidate.preferredLocation, true},
+                 {"salary", &candidate.expectedSalary, true},
+                 {"skills", &candidate.skills, true},
+                 {"radiusKm", &candidate.radiusKm, false}}).read(text);
+    return candidate;
+}
@@ -1,9 +1,15 @@
 #include "job_portal.h"
+#include "tracing.h"
+#include "thread_pool.h"
 #include <iostream>
 #include <algorithm>
 #include <sstream>
 #include <limits>
 #include <queue>
+#include <cctype>
+#include <atomic>
+#include <map>
+#include <tuple>
 
 // --- Utility Function Implementations ---
 
@@ -39,6 +45,25 @@ std::vector<std::string> split(const std::string& s, char delimiter) {
     return tokens;
 }
 
+std::vector<std::string> tokenize(const std::string& s) {
+    std::vector<std::string> tokens;
+    std::string token;
+    auto flush = [&]() {
+        while (!token.empty() && token.back() == '.') token.pop_back();
+        if (!token.empty()) tokens.push_back(token);
+        token.clear();
+    };
+    for (unsigned char c : s) {
+        if (std::isalnum(c) || c == '+' || c == '#' || (c == '.' && !token.empty())) {
+            token.push_back(std::tolower(c));
+        } else {
+            flush();
+        }
+    }
+    flush();
+    return tokens;
+}
+
 // --- Core Logic Implementations ---
 
 void postJob(std::vector<Job>& jobs, InvertedIndex& skillIndex, InvertedIndex& locationIndex, Trie& jobTitleTrie) {
@@ -113,6 +138,48 @@ int relevanceScore(const Job& job, const std::string& keyword) {
     return score;
 }
 
+int fuzzyEditBudget(const std::string& term) {
+    if (term.size() <= 2) return 0;
+    if (term.size() <= 5) return 1;
+    return 2;
+}
+
+std::vector<std::string> jobTerms(const Job& job) {
+    std::vector<std::string> terms = tokenize(job.title);
+    for (const auto& skill : job.skills) {
+        std::string lowerSkill = toLower(skill);
+        terms.push_back(lowerSkill);
+        std::vector<std::string> words = tokenize(lowerSkill);
+        if (words.size() > 1) terms.insert(terms.end(), words.begin(), words.end());
+    }
+    return terms;
+}
+
+std::vector<std::vector<std::string>> expandFuzzyTerms(const Trie& termTrie, const std::string& query) {
+    TRACE_SPAN("search.fuzzy_expand");
+    std::vector<std::vector<std::string>> expansions;
+    for (const auto& word : tokenize(query)) {
+        std::vector<std::string> terms;
+        for (const auto& match : termTrie.searchFuzzy(word, fuzzyEditBudget(word))) {
+            terms.push_back(match.term);
+        }
+        expansions.push_back(std::move(terms));
+    }
+    return expansions;
+}
+
+int fuzzyRelevanceScore(const Job& job, const std::vector<std::vector<std::string>>& expansions) {
+    int score = 0;
+    for (const auto& terms : expansions) {
+        int best = 0;
+        for (const auto& term : terms) {
+            best = std::max(best, relevanceScore(job, term));
+        }
+        score += best;
+    }
+    return score;
+}
+
 void searchJobs(const std::vector<Job>& jobs) {
     std::cout << "Enter keyword to search: ";
     std::string keyword;
@@ -181,6 +248,121 @@ void recommendJobs(const std::vector<Job>& jobs, const InvertedIndex& skillIndex
     }
 }
 
+std::vector<std::vector<ScoredJob>> recommendJobsBatch(const std::vector<Job>& jobs, const SkillMatrix& matrix,
+                                                       const StringInterner& skillNames, const StringInterner& locationNames,
+                                                       const SkillEmbeddings& embeddings, const Gazetteer& gazetteer,
+                                                       const std::vector<Candidate>& candidates, size_t K, ThreadPool* pool) {
+    TRACE_SPAN("recommend.batch");
+    // Candidates sharing a skill set, location and radius score every job identically; only the salary floor differs
+    struct Group {
+        std::vector<uint32_t> skillIds; // Interned, ascending; skills no job requires are dropped
+        LocationPreference where;
+        std::vector<size_t> members;    // Indices into candidates
+        std::vector<std::pair<uint32_t, float>> related; // SkillEmbeddings::related(skillIds)
+    };
+    std::vector<Group> groups;
+    {
+        std::map<std::tuple<std::vector<uint32_t>, std::string, double>, size_t> groupByKey;
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            std::vector<uint32_t> skillIds;
+            for (const auto& skill : candidates[i].skills) {
+                uint32_t id = skillNames.find(toLower(skill));
+                if (id != StringInterner::NotFound) skillIds.push_back(id);
+            }
+            std::sort(skillIds.begin(), skillIds.end());
+            skillIds.erase(std::unique(skillIds.begin(), skillIds.end()), skillIds.end());
+            std::string location = toLower(candidates[i].preferredLocation);
+            double radiusKm = location.empty() ? 0 : std::max(0.0, candidates[i].radiusKm);
+
+            auto [it, inserted] = groupByKey.emplace(std::make_tuple(skillIds, location, radiusKm), groups.size());
+            if (inserted) {
+                LocationPreference where = resolveLocationPreference(location, radiusKm, locationNames, gazetteer);
+                groups.push_back({std::move(skillIds), std::move(where), {}, {}});
+            }
+            groups[it->second].members.push_back(i);
+        }
+    }
+    for (auto& group : groups) group.related = embeddings.related(group.skillIds);
+    // Neighbouring rows with similar skill sets walk the same columns while they are cached
+    std::sort(groups.begin(), groups.end(), [](const Group& a, const Group& b) { return a.skillIds < b.skillIds; });
+
+    std::vector<std::vector<ScoredJob>> results(candidates.size());
+    // One sparse product per block of groups: (groups x skills) * (skills x jobs), where a group's
+    // own skills weigh one more than it has similar skills, and its similar skills 1, so a product
+    // entry carries both counts without the similar ones ever carrying into the exact count.
+    // Each row arrives in ascending job order, so bucketing by exact matches ranks it without
+    // sorting; skillScore is only worked out, and sorted by, for the buckets a top K reads.
+    auto scoreBlock = [&](size_t begin, size_t end) {
+        std::vector<std::vector<uint32_t>> rows(end - begin);
+        std::vector<std::vector<uint32_t>> weights(end - begin);
+        std::vector<uint32_t> exactWeight(end - begin);
+        for (size_t row = 0; row < rows.size(); ++row) {
+            const Group& group = groups[begin + row];
+            exactWeight[row] = group.related.size() + 1; // Each similar skill adds at most 1 per job
+            auto exact = group.skillIds.begin();
+            auto related = group.related.begin();
+            while (exact != group.skillIds.end() || related != group.related.end()) { // Merge, both ascend
+                if (related == group.related.end() || (exact != group.skillIds.end() && *exact < related->first)) {
+                    rows[row].push_back(*exact++);
+                    weights[row].push_back(exactWeight[row]);
+                } else {
+                    rows[row].push_back((related++)->first);
+                    weights[row].push_back(1);
+                }
+            }
+        }
+        std::vector<std::vector<std::vector<int>>> byExact(end - begin);
+        for (size_t row = 0; row < rows.size(); ++row) byExact[row].resize(groups[begin + row].skillIds.size() + 1);
+        matrix.multiply(rows, 0, [&](size_t row, int jobIndex, uint32_t score) {
+            const Group& group = groups[begin + row];
+            if (group.where.accepts(jobs[jobIndex])) byExact[row][score / exactWeight[row]].push_back(jobIndex);
+        }, &weights);
+
+        for (size_t row = 0; row < rows.size(); ++row) {
+            const Group& group = groups[begin + row];
+            std::vector<std::vector<ScoredJob>> ranked(byExact[row].size());
+            std::vector<bool> scored(byExact[row].size(), false);
+            for (size_t member : group.members) {
+                auto& top = results[member];
+                for (size_t exact = byExact[row].size(); exact-- > 0 && top.size() < K;) {
+                    if (!scored[exact]) {
+                        for (int jobIndex : byExact[row][exact]) {
+                            SkillOverlap overlap = skillOverlap(jobs[jobIndex].skillIds, group.skillIds, group.related);
+                            ranked[exact].push_back({jobIndex, overlap.exact, overlap.similar, overlap.score});
+                        }
+                        std::stable_sort(ranked[exact].begin(), ranked[exact].end(),
+                                         [](const ScoredJob& a, const ScoredJob& b) { return a.skillScore > b.skillScore; });
+                        scored[exact] = true;
+                    }
+                    for (const ScoredJob& job : ranked[exact]) {
+                        if (top.size() >= K) break;
+                        if (jobs[job.jobIndex].salary >= candidates[member].expectedSalary) top.push_back(job);
+                    }
+                }
+            }
+        }
+    };
+
+    // Workers pull blocks of groups off a shared counter; each writes only its own members' results
+    size_t blocks = (groups.size() + SkillMatrix::RowBlock - 1) / SkillMatrix::RowBlock;
+    std::atomic<size_t> nextBlock{0};
+    auto work = [&]() {
+        for (size_t b; (b = nextBlock++) < blocks;) {
+            scoreBlock(b * SkillMatrix::RowBlock, std::min(groups.size(), (b + 1) * SkillMatrix::RowBlock));
+        }
+    };
+    size_t workers = std::min((pool ? pool->size() : 0) + 1, blocks);
+    if (workers <= 1) {
+        work();
+    } else {
+        std::vector<std::future<void>> pending;
+        for (size_t i = 1; i < workers; ++i) pending.push_back(pool->submit(work));
+        work();
+        for (auto& f : pending) f.get();
+    }
+    return results;
+}
+
 void autocompleteSearch(const Trie& jobTitleTrie) {
     std::cout << "Enter a prefix to search job titles: ";
     std::string prefix;
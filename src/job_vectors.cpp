@@ -0,0 +1,107 @@
+#include "job_vectors.h"
+#include <algorithm>
+#include <cmath>
+
+JobVectorIndex::JobVectorIndex(HnswIndex::Params params) : params(params), graph(SkillEmbeddings::Dim, params) {}
+
+bool JobVectorIndex::skillSetVector(const std::vector<uint32_t>& skillIds, const SkillEmbeddings& embeddings, float* out) {
+    std::fill(out, out + SkillEmbeddings::Dim, 0.0f);
+    bool any = false;
+    for (uint32_t skillId : skillIds) {
+        const float* v = embeddings.vector(skillId);
+        if (!v) continue;
+        for (size_t d = 0; d < SkillEmbeddings::Dim; ++d) out[d] += v[d];
+        any = true;
+    }
+    if (!any) return false;
+    float norm = std::sqrt(dotProduct(out, out, SkillEmbeddings::Dim));
+    if (norm < 1e-6f) return false;
+    for (size_t d = 0; d < SkillEmbeddings::Dim; ++d) out[d] /= norm;
+    return true;
+}
+
+void JobVectorIndex::insertSet(uint32_t setId, const SkillEmbeddings& embeddings) {
+    float v[SkillEmbeddings::Dim];
+    if (!skillSetVector(setSkills[setId], embeddings, v)) {
+        setNode[setId] = NoNode;
+        return;
+    }
+    setNode[setId] = graph.add(v);
+    nodeSet.push_back(setId);
+}
+
+void JobVectorIndex::addJob(int jobId, const std::vector<uint32_t>& skillIds, const SkillEmbeddings& embeddings) {
+    auto [it, inserted] = setIds.emplace(skillIds, setSkills.size());
+    if (inserted) {
+        setSkills.push_back(skillIds);
+        setJobs.emplace_back();
+        setNode.push_back(NoNode);
+        insertSet(it->second, embeddings);
+    }
+    setJobs[it->second].push_back(jobId);
+    if ((size_t)jobId >= jobSet.size()) jobSet.resize(jobId + 1, NoNode);
+    jobSet[jobId] = it->second;
+}
+
+bool JobVectorIndex::relinkDue(const SkillEmbeddings& embeddings) const {
+    return embeddings.version() != embeddingsVersion && setSkills.size() >= 2 * setsAtBuild;
+}
+
+JobVectorIndex::Snapshot JobVectorIndex::snapshot(const SkillEmbeddings& embeddings) const {
+    Snapshot snapshot;
+    snapshot.params = params;
+    snapshot.embeddingsVersion = embeddings.version();
+    snapshot.sets = setSkills.size();
+    snapshot.vectors.resize(snapshot.sets * SkillEmbeddings::Dim);
+    snapshot.present.resize(snapshot.sets);
+    for (size_t setId = 0; setId < snapshot.sets; ++setId) {
+        snapshot.present[setId] = skillSetVector(setSkills[setId], embeddings, &snapshot.vectors[setId * SkillEmbeddings::Dim]);
+    }
+    return snapshot;
+}
+
+JobVectorIndex::Build JobVectorIndex::build(Snapshot snapshot) {
+    Build next{HnswIndex(SkillEmbeddings::Dim, snapshot.params), snapshot.embeddingsVersion, {}, {}};
+    next.setNode.assign(snapshot.sets, NoNode);
+    for (uint32_t setId = 0; setId < snapshot.sets; ++setId) {
+        if (!snapshot.present[setId]) continue;
+        next.setNode[setId] = next.graph.add(&snapshot.vectors[setId * SkillEmbeddings::Dim]);
+        next.nodeSet.push_back(setId);
+    }
+    return next;
+}
+
+void JobVectorIndex::install(Build next, const SkillEmbeddings& embeddings) {
+    size_t built = next.setNode.size();
+    graph = std::move(next.graph);
+    nodeSet = std::move(next.nodeSet);
+    std::copy(next.setNode.begin(), next.setNode.end(), setNode.begin());
+    for (uint32_t setId = built; setId < setSkills.size(); ++setId) insertSet(setId, embeddings); // Added since the snapshot
+    embeddingsVersion = next.embeddingsVersion;
+    setsAtBuild = built;
+    rebuildCount++;
+}
+
+std::vector<std::pair<int, float>> JobVectorIndex::nearestJobs(const float* query, size_t limit,
+                                                               const std::function<bool(int)>& accept) const {
+    std::vector<std::pair<int, float>> jobs;
+    for (size_t ef = std::max(MinEf, limit);; ef *= 4) {
+        jobs.clear();
+        auto nodes = graph.search(query, ef, ef);
+        for (const auto& [node, similarity] : nodes) {
+            for (int jobId : setJobs[nodeSet[node]]) {
+                if (jobs.size() >= limit) break;
+                if (accept(jobId)) jobs.push_back({jobId, similarity});
+            }
+            if (jobs.size() >= limit) break;
+        }
+        if (jobs.size() >= limit || nodes.size() < ef || ef >= graph.size()) return jobs;
+    }
+}
+
+std::vector<std::pair<int, float>> JobVectorIndex::similarJobs(int jobId, size_t limit) const {
+    if (jobId < 0 || (size_t)jobId >= jobSet.size() || jobSet[jobId] == NoNode) return {};
+    uint32_t node = setNode[jobSet[jobId]];
+    if (node == NoNode) return {};
+    return nearestJobs(graph.vector(node), limit, [jobId](int other) { return other != jobId; });
+}
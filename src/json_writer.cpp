@@ -0,0 +1,52 @@
+#include "json_writer.h"
+#include <charconv>
+#include <cmath>
+
+void JsonWriter::number(double value) {
+    if (!std::isfinite(value)) {
+        null();
+        return;
+    }
+    separate();
+    char buffer[32];
+    char* end = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+    out.append(buffer, end);
+    // Keep doubles recognizable as such, like nlohmann's dump()
+    if (std::string_view(buffer, end - buffer).find_first_of(".e") == std::string_view::npos) out += ".0";
+    afterValue = true;
+}
+
+void JsonWriter::integer(int64_t value) {
+    separate();
+    char buffer[24];
+    out.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+    afterValue = true;
+}
+
+// Quotes and escapes a string; runs of characters needing no escape are appended in one go
+void JsonWriter::appendString(std::string_view value) {
+    static const char hex[] = "0123456789abcdef";
+    out += '"';
+    size_t run = 0;
+    for (size_t i = 0; i < value.size(); ++i) {
+        unsigned char c = value[i];
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+        out.append(value.data() + run, i - run);
+        run = i + 1;
+        switch (c) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\b': out += "\\b"; break;
+        case '\f': out += "\\f"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            out += "\\u00";
+            out += hex[c >> 4];
+            out += hex[c & 0xf];
+        }
+    }
+    out.append(value.data() + run, value.size() - run);
+    out += '"';
+}
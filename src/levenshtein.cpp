@@ -0,0 +1,27 @@
+#include "levenshtein.h"
+#include <algorithm>
+
+LevenshteinAutomaton::LevenshteinAutomaton(const std::string& word, int maxEdits)
+    : word(word), maxEdits(maxEdits) {}
+
+LevenshteinAutomaton::State LevenshteinAutomaton::start() const {
+    State state(word.size() + 1);
+    for (size_t i = 0; i < state.size(); ++i) {
+        state[i] = std::min<int>(i, maxEdits + 1);
+    }
+    return state;
+}
+
+void LevenshteinAutomaton::step(const State& state, char ch, State& next) const {
+    next.resize(state.size());
+    next[0] = std::min(state[0] + 1, maxEdits + 1);
+    for (size_t i = 1; i < state.size(); ++i) {
+        int cost = (word[i - 1] == ch) ? 0 : 1;
+        int best = std::min({state[i - 1] + cost, state[i] + 1, next[i - 1] + 1});
+        next[i] = std::min(best, maxEdits + 1); // Clamp so equivalent states stay equal
+    }
+}
+
+bool LevenshteinAutomaton::canMatch(const State& state) const {
+    return *std::min_element(state.begin(), state.end()) <= maxEdits;
+}
@@ -2,84 +2,468 @@
 #define CROW_JSON_USE_OPTIONAL_ERROR_CHECKING
 #include "crow.h"
 #include "include/job_portal.h"
+#include "include/job_json.h"
+#include "include/sharded_search.h"
+#include "include/query_cache.h"
+#include "include/string_interner.h"
+#include "include/facets.h"
+#include "include/metrics.h"
+#include "include/tracing.h"
+#include "include/slow_query_log.h"
+#include "include/session_store.h"
+#include "include/recommendations.h"
+#include "include/push_hub.h"
+#include "include/job_vectors.h"
+#include "include/geo.h"
+#include "include/json_writer.h"
+#include "include/compression.h"
+#include "include/static_assets.h"
+#include "include/wire_format.h"
 #include <nlohmann/json.hpp>
 #include <sstream>
+#include <iostream>
 #include <queue>
 #include <algorithm>
-#include <fstream>
 #include <string>
+#include <string_view>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <shared_mutex>
+#include <limits>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+#include <functional>
 
 using json = nlohmann::json;
 
 // Global data structures
 std::vector<Job> jobs;
-std::unordered_map<std::string, Candidate> candidates; // sessionId -> Candidate
 InvertedIndex skillIndex;
 InvertedIndex locationIndex;
+SkillMatrix skillMatrix; // Job x Job::skillIds incidence, for recommendations
+SkillEmbeddings skillEmbeddings; // Skill co-occurrence vectors, for similar-skill matching
+JobVectorIndex jobVectors(HnswIndex::Params{}); // HNSW over job skill vectors, for "more like this"
+RecommendationSubscriptions recommendationSubscriptions; // Skill id -> profiles to notify on ingest
+PushHub pushHub(PushHub::Limits{}); // /ws/recommendations connections and their outboxes
 Trie jobTitleTrie;
+Trie termTrie; // Lowercased title words and skills, for typo-tolerant search
+// Per-shard trigram indexes over titles and skills, searched in parallel
+ShardedSearch searchShards(std::max(1u, std::thread::hardware_concurrency()));
+// Workers for batch recommendations; concurrent batches share them rather than each starting its own
+ThreadPool recommendPool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+StringInterner skillNames;    // Lowercased skill -> Job::skillIds
+StringInterner locationNames; // Lowercased location -> Job::locationId
+Gazetteer gazetteer; // Offline place names and coordinates, from GAZETTEER_PATH (default data/gazetteer.tsv)
+std::vector<std::vector<int>> placeJobs; // Gazetteer place -> jobs located there, ascending
 
-// Helper function to convert Job to JSON
-json jobToJson(const Job& job, int index = -1) {
-    json j;
-    if (index >= 0) j["id"] = index;
-    j["title"] = job.title;
-    j["company"] = job.company;
-    j["location"] = job.location;
-    j["salary"] = job.salary;
-    j["skills"] = job.skills;
-    j["description"] = job.description;
-    return j;
+// Ingest takes catalogMutex exclusively; readers of jobs and the indexes share it
+std::shared_mutex catalogMutex;
+std::atomic<uint64_t> catalogGeneration{0}; // Bumped on every ingest
+// Rebuilds the skill embeddings and relinks the job vector graph off the ingest path, one at a time
+ThreadPool indexBuilder(1);
+std::atomic<bool> indexBuildQueued{false};
+QueryCache searchCache(4096); // Serialized /api/jobs/search responses, versioned by catalogGeneration
+RequestMetrics requestMetrics;
+
+// Search and recommendation requests slower than SLOW_QUERY_MS (default 50) are logged,
+// with their plan, to SLOW_QUERY_LOG (default stderr)
+uint64_t slowQueryThresholdMicros() {
+    const char* ms = std::getenv("SLOW_QUERY_MS");
+    return ms ? (uint64_t)(std::strtod(ms, nullptr) * 1000) : 50000;
+}
+SlowQueryLog slowQueryLog(slowQueryThresholdMicros(), std::getenv("SLOW_QUERY_LOG") ? std::getenv("SLOW_QUERY_LOG") : "");
+
+// sessionId -> Candidate. Sessions idle for SESSION_TTL_SECONDS (default 1800) expire, and
+// the least recently used are evicted once all profiles take more than SESSION_MAX_MB (default 256)
+long envOr(const char* name, long fallback) {
+    const char* value = std::getenv(name);
+    return value ? std::strtol(value, nullptr, 10) : fallback;
+}
+SessionStore candidates((size_t)envOr("SESSION_MAX_MB", 256) << 20, std::chrono::seconds(envOr("SESSION_TTL_SECONDS", 1800)));
+
+// Times every request and records it per route, status class and response size
+struct MetricsMiddleware {
+    struct context {
+        std::chrono::steady_clock::time_point started;
+    };
+
+    void before_handle(crow::request& /*req*/, crow::response& /*res*/, context& ctx) {
+        ctx.started = std::chrono::steady_clock::now();
+    }
+
+    void after_handle(crow::request& req, crow::response& res, context& ctx) {
+        auto elapsed = std::chrono::steady_clock::now() - ctx.started;
+        requestMetrics.record(crow::method_name(req.method), req.url, res.code, res.body.size(),
+                              std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+    }
+};
+
+// Compresses responses of at least COMPRESS_MIN_BYTES (default 1024) in the encoding the client
+// accepts. Runs before MetricsMiddleware's after_handle, so metrics count the bytes sent.
+struct CompressionMiddleware {
+    struct context {
+        bool skip = false; // Set by handlers that negotiate their own encoding
+    };
+    size_t minBytes = envOr("COMPRESS_MIN_BYTES", 1024);
+
+    void before_handle(crow::request& /*req*/, crow::response& /*res*/, context& /*ctx*/) {}
+
+    void after_handle(crow::request& req, crow::response& res, context& ctx) {
+        if (ctx.skip || res.body.size() < minBytes || !res.get_header_value("Content-Encoding").empty()) return;
+        std::string vary = res.get_header_value("Vary");
+        res.set_header("Vary", vary.empty() ? "Accept-Encoding" : vary + ", Accept-Encoding");
+        ContentEncoding encoding = negotiateEncoding(req.get_header_value("Accept-Encoding"));
+        if (encoding == ContentEncoding::Identity) return;
+        res.body = compress(res.body, encoding, 1); // Fastest level: this is on the request path
+        res.set_header("Content-Encoding", encodingName(encoding));
+    }
+};
+
+StaticAssets webAssets; // web/, read and precompressed once at startup
+
+// Admin endpoints expose raw user queries and can clear diagnostics. With ADMIN_TOKEN set they
+// need "Authorization: Bearer <token>"; without it they answer loopback clients only.
+bool adminAllowed(const crow::request& req) {
+    static const char* token = std::getenv("ADMIN_TOKEN");
+    if (token && *token) {
+        std::string expected = std::string("Bearer ") + token;
+        const std::string& given = req.get_header_value("Authorization");
+        // Compared in full, so the time taken does not reveal how much of the token matched
+        unsigned char diff = given.size() != expected.size();
+        for (size_t i = 0; i < given.size() && i < expected.size(); ++i) diff |= given[i] ^ expected[i];
+        return diff == 0;
+    }
+    const std::string& ip = req.remote_ip_address;
+    return ip == "127.0.0.1" || ip == "::1" || ip == "::ffff:127.0.0.1";
+}
+
+crow::response adminForbidden() {
+    json error;
+    error["success"] = false;
+    error["message"] = "Admin endpoints need ADMIN_TOKEN or a loopback client";
+    return crow::response(403, error.dump());
+}
+
+// ETag of a catalog read: the generation it saw plus a hash of its canonical parameters.
+// The process start time keeps a restarted server, whose generations begin again at 0,
+// from matching ETags handed out before.
+std::string catalogEtag(uint64_t generation, std::string_view key) {
+    static const std::string run = std::to_string(std::time(nullptr));
+    char hash[17];
+    snprintf(hash, sizeof(hash), "%016zx", std::hash<std::string_view>()(key));
+    return "W/\"" + run + "-" + std::to_string(generation) + "-" + hash + "\"";
+}
+
+// Labels a body rendered in a negotiated format; responses differ by Accept
+crow::response withFormat(crow::response res, WireFormat format) {
+    res.set_header("Content-Type", contentTypeFor(format));
+    res.set_header("Vary", "Accept");
+    return res;
+}
+
+crow::response withEtag(crow::response res, const std::string& etag) {
+    res.set_header("ETag", etag);
+    res.set_header("Cache-Control", "no-cache"); // Cache, but revalidate
+    return res;
+}
+
+// A web/ file in the encoding the client accepts, or 304 if its cached copy is current
+crow::response serveAsset(const crow::request& req, const std::string& path) {
+    const StaticAsset* asset = webAssets.find(path);
+    if (!asset) return crow::response(404, "web/" + path + " not found");
+    crow::response res;
+    res.set_header("ETag", asset->etag);
+    res.set_header("Last-Modified", asset->lastModified);
+    res.set_header("Cache-Control", "no-cache"); // Cache, but revalidate; a 304 is cheap
+    res.set_header("Vary", "Accept-Encoding");
+    if (notModified(*asset, req.get_header_value("If-None-Match"), req.get_header_value("If-Modified-Since"))) {
+        res.code = 304;
+        return res;
+    }
+    ContentEncoding encoding = negotiateEncoding(req.get_header_value("Accept-Encoding"));
+    res.body = asset->bodyFor(encoding);
+    if (encoding != ContentEncoding::Identity) res.set_header("Content-Encoding", encodingName(encoding));
+    res.set_header("Content-Type", asset->contentType);
+    return res;
+}
+
+// Optional refinements of a search, as picked from its facets
+struct SearchFilter {
+    uint32_t skillId = StringInterner::NotFound;
+    LocationPreference where;
+    bool unknownValue = false; // Filtered on a skill/location no job has
+    double minSalary = -std::numeric_limits<double>::infinity();
+    double maxSalary = std::numeric_limits<double>::infinity();
+
+    bool accepts(const Job& job) const {
+        if (unknownValue || job.salary < minSalary || job.salary >= maxSalary) return false;
+        if (!where.accepts(job)) return false;
+        if (skillId != StringInterner::NotFound &&
+            std::find(job.skillIds.begin(), job.skillIds.end(), skillId) == job.skillIds.end()) return false;
+        return true;
+    }
+};
+
+template <class Writer>
+void writeFacets(Writer& out, const Facets& facets) {
+    auto writeBuckets = [&](const char* name, const std::vector<FacetBucket>& buckets, const StringInterner& names) {
+        out.key(name);
+        out.beginArray();
+        for (const auto& bucket : buckets) {
+            out.beginObject();
+            out.key("value");
+            out.string(names.str(bucket.id));
+            out.key("count");
+            out.integer(bucket.count);
+            out.endObject();
+        }
+        out.endArray();
+    };
+    out.beginObject();
+    writeBuckets("skills", facets.skills, skillNames);
+    writeBuckets("locations", facets.locations, locationNames);
+    out.key("salary");
+    out.beginArray();
+    const auto& edges = salaryBucketEdges();
+    for (size_t i = 0; i < edges.size(); ++i) {
+        out.beginObject();
+        out.key("min");
+        out.number(edges[i]);
+        if (i + 1 < edges.size()) {
+            out.key("max");
+            out.number(edges[i + 1]);
+        }
+        out.key("count");
+        out.integer(facets.salaryHistogram[i]);
+        out.endObject();
+    }
+    out.endArray();
+    out.endObject();
+}
+
+// Jobs as an array, each with extra fields written by `extra(out, item)` after the job's own
+template <class Writer, class Items, class JobOf, class Extra>
+void writeJobs(Writer& out, const Items& items, JobOf jobOf, Extra extra) {
+    out.beginArray();
+    for (const auto& item : items) {
+        int jobId = jobOf(item);
+        out.beginObject();
+        writeJobFields(out, jobs[jobId], jobId);
+        extra(out, item);
+        out.endObject();
+    }
+    out.endArray();
+}
+
+// Readable, canonical form of the given query parameters for the slow-query log:
+// lowercased, whitespace collapsed, absent parameters left out
+std::string normalizeQueryParams(const crow::request& req, std::initializer_list<const char*> names) {
+    std::string normalized;
+    for (const char* name : names) {
+        const char* value = req.url_params.get(name);
+        if (!value) continue;
+        if (!normalized.empty()) normalized += ' ';
+        normalized += name;
+        normalized += '=';
+        std::istringstream words(toLower(value));
+        std::string word;
+        for (bool first = true; words >> word; first = false) {
+            if (!first) normalized += ' ';
+            normalized += word;
+        }
+    }
+    return normalized;
+}
+
+// Runs on indexBuilder while ingest and readers carry on: each build's inputs are copied under
+// the shared catalog lock and the result is swapped in under the exclusive one. Repeats while
+// ingest has made another build due in the meantime; a relink follows the embeddings it uses.
+void rebuildIndexes() {
+    for (;;) {
+        std::shared_lock<std::shared_mutex> lock(catalogMutex);
+        if (skillEmbeddings.rebuildDue()) {
+            auto snapshot = skillEmbeddings.snapshot();
+            lock.unlock();
+            auto next = SkillEmbeddings::build(std::move(snapshot));
+            std::unique_lock<std::shared_mutex> writeLock(catalogMutex);
+            skillEmbeddings.install(std::move(next));
+        } else if (jobVectors.relinkDue(skillEmbeddings)) {
+            auto snapshot = jobVectors.snapshot(skillEmbeddings);
+            lock.unlock();
+            auto next = JobVectorIndex::build(std::move(snapshot));
+            std::unique_lock<std::shared_mutex> writeLock(catalogMutex);
+            jobVectors.install(std::move(next), skillEmbeddings);
+        } else {
+            indexBuildQueued = false; // indexJob checks under the exclusive lock, so no due build is missed
+            return;
+        }
+    }
+}
+
+// Appends a job and updates every index; the caller holds catalogMutex exclusively
+int indexJob(Job newJob) {
+    for (const auto& skill : newJob.skills) {
+        newJob.skillIds.push_back(skillNames.intern(toLower(skill)));
+    }
+    std::sort(newJob.skillIds.begin(), newJob.skillIds.end());
+    newJob.skillIds.erase(std::unique(newJob.skillIds.begin(), newJob.skillIds.end()), newJob.skillIds.end());
+    newJob.locationId = locationNames.intern(toLower(newJob.location));
+    newJob.placeId = gazetteer.resolve(newJob.location);
+    jobs.push_back(std::move(newJob));
+    int newJobIndex = jobs.size() - 1;
+    const Job& job = jobs.back();
+
+    // Update indexes
+    for (const auto& skill : job.skills) {
+        skillIndex[toLower(skill)].push_back(newJobIndex);
+    }
+    locationIndex[toLower(job.location)].push_back(newJobIndex);
+    if (job.placeId != Gazetteer::NoPlace) placeJobs[job.placeId].push_back(newJobIndex);
+    skillMatrix.addJob(job.skillIds);
+    skillEmbeddings.addJob(job.skillIds);
+    jobVectors.addJob(newJobIndex, job.skillIds, skillEmbeddings);
+    if ((skillEmbeddings.rebuildDue() || jobVectors.relinkDue(skillEmbeddings)) && !indexBuildQueued.exchange(true)) {
+        indexBuilder.submit(rebuildIndexes);
+    }
+    recommendationSubscriptions.publish(jobs, newJobIndex, skillNames, locationNames);
+    jobTitleTrie.insert(job.title);
+    for (const auto& term : jobTerms(job)) {
+        termTrie.insert(term);
+    }
+    searchShards.addJob(newJobIndex, job);
+    return newJobIndex;
+}
+
+// Routes, gauges and counters exported at /metrics; must run before the server starts
+void registerMetrics() {
+    requestMetrics.addRoute("GET", "/");
+    requestMetrics.addRoute("GET", "/web/<path>");
+    requestMetrics.addRoute("POST", "/api/jobs");
+    requestMetrics.addRoute("GET", "/api/jobs");
+    requestMetrics.addRoute("POST", "/api/jobs/bulk");
+    requestMetrics.addRoute("GET", "/api/jobs/search");
+    requestMetrics.addRoute("GET", "/api/stats/cache");
+    requestMetrics.addRoute("GET", "/api/autocomplete");
+    requestMetrics.addRoute("GET", "/api/skills/similar");
+    requestMetrics.addRoute("GET", "/api/jobs/<int>/similar");
+    requestMetrics.addRoute("GET", "/api/jobs/near");
+    requestMetrics.addRoute("POST", "/api/profile");
+    requestMetrics.addRoute("GET", "/api/recommendations");
+    requestMetrics.addRoute("GET", "/ws/recommendations");
+    requestMetrics.addRoute("POST", "/api/recommendations/batch");
+    requestMetrics.addRoute("GET", "/api/recommendations/vector");
+    requestMetrics.addRoute("GET", "/metrics");
+    requestMetrics.addRoute("GET", "/api/admin/trace");
+    requestMetrics.addRoute("GET", "/api/admin/slow-queries");
+
+    auto underCatalogLock = [](auto read) {
+        return [read]() -> double {
+            std::shared_lock<std::shared_mutex> lock(catalogMutex);
+            return read();
+        };
+    };
+    requestMetrics.addGauge("job_portal_jobs", "Jobs in the catalog.", underCatalogLock([] { return jobs.size(); }));
+    requestMetrics.addGauge("job_portal_catalog_generation", "Catalog generation, bumped on every ingest.",
+                            [] { return catalogGeneration.load(); });
+    requestMetrics.addGauge("job_portal_skill_index_keys", "Distinct skills in the skill index.",
+                            underCatalogLock([] { return skillIndex.size(); }));
+    requestMetrics.addGauge("job_portal_location_index_keys", "Distinct locations in the location index.",
+                            underCatalogLock([] { return locationIndex.size(); }));
+    requestMetrics.addGauge("job_portal_trigram_keys", "Trigram posting lists across all search shards.",
+                            underCatalogLock([] { return searchShards.trigramCount(); }));
+    requestMetrics.addGauge("job_portal_title_trie_nodes", "Nodes in the job title autocomplete trie.",
+                            underCatalogLock([] { return jobTitleTrie.nodeCount(); }));
+    requestMetrics.addGauge("job_portal_term_trie_nodes", "Nodes in the fuzzy-search term trie.",
+                            underCatalogLock([] { return termTrie.nodeCount(); }));
+    requestMetrics.addGauge("job_portal_search_cache_entries", "Entries in the search response cache.",
+                            [] { return searchCache.stats().entries; });
+    requestMetrics.addGauge("job_portal_vector_nodes", "Distinct job skill sets in the HNSW similarity graph.",
+                            underCatalogLock([] { return jobVectors.nodeCount(); }));
+    requestMetrics.addCounter("job_portal_vector_rebuilds_total", "HNSW graph rebuilds after the skill embeddings changed.",
+                            underCatalogLock([] { return jobVectors.rebuilds(); }));
+    requestMetrics.addCounter("job_portal_search_cache_hits_total", "Search cache hits since start.",
+                            [] { return searchCache.stats().hits; });
+    requestMetrics.addCounter("job_portal_search_cache_misses_total", "Search cache misses since start.",
+                            [] { return searchCache.stats().misses; });
+    requestMetrics.addGauge("job_portal_candidates", "Candidate profiles held in memory.",
+                            [] { return candidates.stats().sessions; });
+    requestMetrics.addGauge("job_portal_recommendation_subscriptions", "Profile-skill subscriptions in the reverse index, including lapsed ones not yet pruned.",
+                            [] { return recommendationSubscriptions.subscriptionCount(); });
+    requestMetrics.addGauge("job_portal_push_connections", "Open /ws/recommendations subscriptions.",
+                            [] { return pushHub.stats().connections; });
+    requestMetrics.addGauge("job_portal_push_queued_bytes", "Matches queued for push connections, not yet sent.",
+                            [] { return pushHub.stats().queuedBytes; });
+    requestMetrics.addCounter("job_portal_push_dropped_total", "Matches dropped from full push queues since start.",
+                            [] { return pushHub.stats().dropped; });
+    requestMetrics.addGauge("job_portal_candidate_bytes", "Approximate memory held by candidate profiles.",
+                            [] { return candidates.stats().bytes; });
+    requestMetrics.addCounter("job_portal_candidate_expirations_total", "Candidate sessions dropped after the idle TTL.",
+                            [] { return candidates.stats().expirations; });
+    requestMetrics.addCounter("job_portal_candidate_evictions_total", "Candidate sessions evicted by the memory limit.",
+                            [] { return candidates.stats().evictions; });
+    requestMetrics.addCounter("job_portal_slow_queries_logged_total", "Requests written to the slow-query log since start.",
+                            [] { return slowQueryLog.logged(); });
+    requestMetrics.addCounter("job_portal_slow_queries_dropped_total", "Slow-query log entries dropped because the queue was full.",
+                            [] { return slowQueryLog.dropped(); });
 }
 
 int main() {
-    crow::SimpleApp app;
+    crow::App<MetricsMiddleware, CompressionMiddleware> app;
+    registerMetrics();
+    if (webAssets.load("web") == 0) std::cerr << "No files under web/; / will answer 404\n";
+    std::string gazetteerPath = std::getenv("GAZETTEER_PATH") ? std::getenv("GAZETTEER_PATH") : "data/gazetteer.tsv";
+    if (gazetteer.load(gazetteerPath) < 0) {
+        std::cerr << "Gazetteer " << gazetteerPath << " not found; locations match by name only\n";
+    }
+    placeJobs.resize(gazetteer.size());
 
-    // Serve static HTML page
+    // Serve static HTML page and the other web/ assets, precompressed
     CROW_ROUTE(app, "/")
-    ([]() -> crow::response {
-        std::ifstream file("web/index.html");
-        if (file) {
-            std::string content((std::istreambuf_iterator<char>(file)), 
-                               std::istreambuf_iterator<char>());
-            auto resp = crow::response(content);
-            resp.set_header("Content-Type", "text/html");
-            return resp;
-        }
-        return crow::response(404, "web/index.html not found");
+    ([&app](const crow::request& req) -> crow::response {
+        app.get_context<CompressionMiddleware>(req).skip = true;
+        return serveAsset(req, "index.html");
+    });
+    CROW_ROUTE(app, "/web/<path>")
+    ([&app](const crow::request& req, std::string path) -> crow::response {
+        app.get_context<CompressionMiddleware>(req).skip = true;
+        return serveAsset(req, path);
     });
 
     // API: Post a new job
     CROW_ROUTE(app, "/api/jobs")
     .methods("POST"_method)([](const crow::request& req) -> crow::response {
+        TRACE_SPAN("POST /api/jobs");
         try {
-            auto body = json::parse(req.body);
             Job newJob;
-            newJob.title = body["title"].get<std::string>();
-            newJob.company = body["company"].get<std::string>();
-            newJob.location = body["location"].get<std::string>();
-            newJob.salary = body["salary"].get<double>();
-            newJob.description = body.value("description", "");
-            
-            for (const auto& skill : body["skills"]) {
-                newJob.skills.push_back(skill.get<std::string>());
+            {
+                TRACE_SPAN("ingest.parse");
+                newJob = jobFromJsonText(req.body);
             }
 
-            jobs.push_back(newJob);
-            int newJobIndex = jobs.size() - 1;
-
-            // Update indexes
-            for (const auto& skill : newJob.skills) {
-                skillIndex[toLower(skill)].push_back(newJobIndex);
+            std::unique_lock<std::shared_mutex> lock(catalogMutex);
+            int newJobIndex;
+            {
+                TRACE_SPAN("ingest.index");
+                newJobIndex = indexJob(newJob);
             }
-            locationIndex[toLower(newJob.location)].push_back(newJobIndex);
-            jobTitleTrie.insert(newJob.title);
+            catalogGeneration++; // Invalidates every cached search response
+            lock.unlock();
 
-            json response;
-            response["success"] = true;
-            response["message"] = "Job posted successfully!";
-            response["job"] = jobToJson(newJob, newJobIndex);
-            
-            return crow::response(response.dump());
+            std::string body;
+            JsonWriter out(body);
+            out.beginObject();
+            out.key("success");
+            out.boolean(true);
+            out.key("message");
+            out.string("Job posted successfully!");
+            out.key("job");
+            out.beginObject();
+            writeJobFields(out, newJob, newJobIndex);
+            out.endObject();
+            out.endObject();
+            return crow::response(std::move(body));
         } catch (const std::exception& e) {
             json error;
             error["success"] = false;
@@ -88,19 +472,80 @@ int main() {
         }
     });
 
+    // API: Bulk ingest, one JSON job per line (NDJSON). Bad lines are reported and skipped.
+    CROW_ROUTE(app, "/api/jobs/bulk")
+    .methods("POST"_method)([](const crow::request& req) -> crow::response {
+        TRACE_SPAN("POST /api/jobs/bulk");
+        std::vector<Job> parsed;
+        json errors = json::array();
+        {
+            TRACE_SPAN("ingest.parse");
+            // Lines are parsed in place, as views into the request body
+            std::string_view body(req.body);
+            for (size_t start = 0, lineNumber = 1; start < body.size(); ++lineNumber) {
+                size_t end = std::min(body.find('\n', start), body.size());
+                std::string_view line = body.substr(start, end - start);
+                start = end + 1;
+                if (line.find_first_not_of(" \t\r") == std::string_view::npos) continue;
+                try {
+                    parsed.push_back(jobFromJsonText(line));
+                } catch (const std::exception& e) {
+                    errors.push_back({{"line", lineNumber}, {"message", e.what()}});
+                }
+            }
+        }
+
+        // One exclusive section and one generation bump for the whole batch
+        int firstId = -1;
+        if (!parsed.empty()) {
+            std::unique_lock<std::shared_mutex> lock(catalogMutex);
+            TRACE_SPAN("ingest.index");
+            firstId = jobs.size();
+            for (auto& job : parsed) {
+                indexJob(std::move(job));
+            }
+            catalogGeneration++;
+        }
+
+        json response;
+        response["success"] = errors.empty();
+        response["inserted"] = parsed.size();
+        if (firstId >= 0) response["firstId"] = firstId;
+        response["errors"] = errors;
+        return crow::response(errors.empty() || !parsed.empty() ? 200 : 400, response.dump());
+    });
+
     // API: Get all jobs
     CROW_ROUTE(app, "/api/jobs")
-    .methods("GET"_method)([]() -> crow::response {
-        json response;
-        response["jobs"] = json::array();
-        for (size_t i = 0; i < jobs.size(); ++i) {
-            response["jobs"].push_back(jobToJson(jobs[i], i));
-        }
-        return crow::response(response.dump());
+    .methods("GET"_method)([](const crow::request& req) -> crow::response {
+        WireFormat format = negotiateFormat(req.get_header_value("Accept"));
+        std::string key = std::string("jobs:") + formatName(format);
+        uint64_t current = catalogGeneration.load();
+        std::string etag = catalogEtag(current, key);
+        if (etagMatches(req.get_header_value("If-None-Match"), etag)) return withEtag(crow::response(304), etag);
+        static ResponseSizeHint sizeHint(4096);
+        std::shared_lock<std::shared_mutex> lock(catalogMutex);
+        if (catalogGeneration.load() != current) etag = catalogEtag(catalogGeneration.load(), key); // Stable while the lock is held
+        std::string body = renderAs(format, sizeHint.get(), [](auto& out) {
+            out.beginObject();
+            out.key("jobs");
+            out.beginArray();
+            for (size_t i = 0; i < jobs.size(); ++i) {
+                out.beginObject();
+                writeJobFields(out, jobs[i], i);
+                out.endObject();
+            }
+            out.endArray();
+            out.endObject();
+        });
+        lock.unlock();
+        sizeHint.update(body.size());
+        return withEtag(withFormat(crow::response(std::move(body)), format), etag);
     });
 
     // API: Search jobs by keyword
     CROW_ROUTE(app, "/api/jobs/search")( [](const crow::request& req) -> crow::response {
+        TRACE_SPAN("GET /api/jobs/search");
         auto keyword = req.url_params.get("q");
         if (!keyword) {
             json error;
@@ -109,56 +554,345 @@ int main() {
             return crow::response(400, error.dump());
         }
 
+        auto started = std::chrono::steady_clock::now();
+        QueryPlan plan("/api/jobs/search");
+        const char* fuzzyParam = req.url_params.get("fuzzy");
+        bool fuzzy = !(fuzzyParam && std::string(fuzzyParam) == "false");
+        const char* facetsParam = req.url_params.get("facets");
+        bool withFacets = facetsParam && std::string(facetsParam) == "true";
+        const char* skillParam = req.url_params.get("skill");
+        const char* locationParam = req.url_params.get("location");
+        const char* radiusParam = req.url_params.get("radiusKm");
+        const char* minSalaryParam = req.url_params.get("minSalary");
+        const char* maxSalaryParam = req.url_params.get("maxSalary");
+        std::string skillFilter = skillParam ? toLower(skillParam) : "";
+        std::string locationFilter = locationParam ? toLower(locationParam) : "";
+        double radiusKm = radiusParam ? std::max(0.0, std::strtod(radiusParam, nullptr)) : 0;
+
+        // Scoring is case-insensitive, so the lowercased query is the canonical key.
+        // Whitespace is kept as-is because substring matching treats it literally.
+        WireFormat format = negotiateFormat(req.get_header_value("Accept"));
+        std::string cacheKey = std::string(fuzzy ? "search:fuzzy" : "search:exact") + (withFacets ? ":facets:" : ":") + formatName(format);
+        for (const std::string& part : {skillFilter, locationFilter, std::to_string(radiusKm), std::string(minSalaryParam ? minSalaryParam : ""),
+                                        std::string(maxSalaryParam ? maxSalaryParam : ""), toLower(keyword)}) {
+            cacheKey += '\x1f';
+            cacheKey += part;
+        }
+
+        // The client's copy is current while the catalog has not changed: answer before any work
+        uint64_t current = catalogGeneration.load();
+        std::string etag = catalogEtag(current, cacheKey);
+        if (etagMatches(req.get_header_value("If-None-Match"), etag)) return withEtag(crow::response(304), etag);
+
+        std::string body;
+        bool cached;
+        {
+            TRACE_SPAN("search.cache_lookup");
+            cached = searchCache.get(cacheKey, current, body);
+        }
+        plan.endPhase("cache_lookup");
+        if (cached) {
+            searchCache.recordLatency(true, std::chrono::steady_clock::now() - started);
+            return withEtag(withFormat(crow::response(std::move(body)), format), etag);
+        }
+
+        std::shared_lock<std::shared_mutex> lock(catalogMutex, std::defer_lock);
+        {
+            TRACE_SPAN("search.lock_wait");
+            lock.lock();
+        }
+        plan.endPhase("lock_wait");
+        uint64_t generation = catalogGeneration.load(); // Stable while the lock is held
+        if (generation != current) etag = catalogEtag(generation, cacheKey);
         const int K = 10;
-        using ScorePair = std::pair<int, int>;
-        std::priority_queue<ScorePair, std::vector<ScorePair>, std::greater<ScorePair>> topKJobs;
-
-        for (size_t i = 0; i < jobs.size(); ++i) {
-            int score = relevanceScore(jobs[i], keyword);
-            if (score > 0) {
-                if (topKJobs.size() < K) {
-                    topKJobs.push({score, (int)i});
-                } else if (score > topKJobs.top().first) {
-                    topKJobs.pop();
-                    topKJobs.push({score, (int)i});
+        std::string query = keyword;
+        SearchFilter filter;
+        if (!skillFilter.empty()) {
+            plan.candidateSkills = 1;
+            filter.skillId = skillNames.find(skillFilter);
+            filter.unknownValue |= filter.skillId == StringInterner::NotFound;
+        }
+        if (!locationFilter.empty()) {
+            filter.where = resolveLocationPreference(locationFilter, radiusKm, locationNames, gazetteer);
+            filter.unknownValue |= filter.where.locationId == StringInterner::NotFound && filter.where.places.empty();
+        }
+        if (minSalaryParam) filter.minSalary = std::strtod(minSalaryParam, nullptr);
+        if (maxSalaryParam) filter.maxSalary = std::strtod(maxSalaryParam, nullptr);
+
+        // Only jobs sharing every trigram of the query can contain it; verify those.
+        // Facets need the full match set, not just the top K.
+        SearchResult found;
+        {
+            TRACE_SPAN("search.score");
+            found = searchShards.search(jobs, {query}, K, [&](const Job& job) {
+                return filter.accepts(job) ? relevanceScore(job, query) : 0;
+            }, withFacets);
+        }
+        plan.postingsTouched += found.postingsTouched;
+        plan.jobsScored += found.scored;
+        plan.endPhase("score");
+
+        // Nothing matched as typed: retry with dictionary terms within a small edit distance
+        std::vector<std::vector<std::string>> expansions;
+        if (found.top.empty() && fuzzy) {
+            TRACE_SPAN("search.fuzzy");
+            expansions = expandFuzzyTerms(termTrie, query);
+            std::vector<std::string> terms;
+            for (const auto& words : expansions) {
+                terms.insert(terms.end(), words.begin(), words.end());
+            }
+            found = searchShards.search(jobs, terms, K, [&](const Job& job) {
+                return filter.accepts(job) ? fuzzyRelevanceScore(job, expansions) : 0;
+            }, withFacets);
+            plan.postingsTouched += found.postingsTouched;
+            plan.jobsScored += found.scored;
+            plan.endPhase("fuzzy");
+        }
+
+        static ResponseSizeHint sizeHint(4096);
+        body = renderAs(format, sizeHint.get(), [&](auto& out) {
+            out.beginObject();
+            {
+                TRACE_SPAN("search.render");
+                out.key("results");
+                writeJobs(out, found.top, [](const auto& p) { return p.second; }, [](auto& out, const auto& p) {
+                    out.key("score");
+                    out.integer(p.first);
+                });
+                if (!found.top.empty() && !expansions.empty()) {
+                    out.key("fuzzy");
+                    out.boolean(true);
+                    out.key("expandedTerms");
+                    out.beginArray();
+                    for (const auto& words : expansions) {
+                        out.beginArray();
+                        for (const auto& word : words) out.string(word);
+                        out.endArray();
+                    }
+                    out.endArray();
                 }
             }
+            if (withFacets) {
+                TRACE_SPAN("search.facets");
+                out.key("total");
+                out.integer(found.matched.size());
+                out.key("facets");
+                writeFacets(out, computeFacets(jobs, found.matched, skillNames.size(), locationNames.size(), 10));
+            }
+            out.endObject();
+        });
+        lock.unlock();
+        sizeHint.update(body.size());
+        plan.results = found.top.size();
+        plan.endPhase("render");
+        searchCache.put(cacheKey, generation, body);
+        searchCache.recordLatency(false, std::chrono::steady_clock::now() - started);
+
+        // Cache hits return above; only a computed response can be pathologically slow
+        if (slowQueryLog.isSlow(plan.finish())) {
+            plan.query = normalizeQueryParams(req, {"q", "skill", "location", "radiusKm", "minSalary", "maxSalary", "fuzzy", "facets"});
+            slowQueryLog.submit(std::move(plan));
         }
+        return withEtag(withFormat(crow::response(std::move(body)), format), etag);
+    });
+
+    // API: Search cache statistics
+    CROW_ROUTE(app, "/api/stats/cache")([]() -> crow::response {
+        QueryCache::Stats stats = searchCache.stats();
+        uint64_t lookups = stats.hits + stats.misses;
+        json response;
+        response["generation"] = catalogGeneration.load();
+        response["entries"] = stats.entries;
+        response["hits"] = stats.hits;
+        response["misses"] = stats.misses;
+        response["hitRate"] = lookups ? (double)stats.hits / lookups : 0.0;
+        response["stale"] = stats.stale;
+        response["insertions"] = stats.insertions;
+        response["evictions"] = stats.evictions;
+        response["rejections"] = stats.rejections;
+        response["avgHitMicros"] = stats.avgHitMicros;
+        response["avgMissMicros"] = stats.avgMissMicros;
+        return crow::response(response.dump());
+    });
 
-        std::vector<ScorePair> results;
-        while (!topKJobs.empty()) {
-            results.push_back(topKJobs.top());
-            topKJobs.pop();
+    // Prometheus scrape endpoint
+    CROW_ROUTE(app, "/metrics")([]() -> crow::response {
+        crow::response res(requestMetrics.render());
+        res.set_header("Content-Type", "text/plain; version=0.0.4");
+        return res;
+    });
+
+    // Admin: recent tracing spans as Chrome trace-event JSON; ?clear=true empties the buffers after dumping
+    CROW_ROUTE(app, "/api/admin/trace")([](const crow::request& req) -> crow::response {
+        if (!adminAllowed(req)) return adminForbidden();
+        if (!tracingEnabled) {
+            json error;
+            error["success"] = false;
+            error["message"] = "Tracing is not compiled in; rebuild with TRACING=1";
+            return crow::response(404, error.dump());
         }
-        std::reverse(results.begin(), results.end());
+        crow::response res(dumpChromeTrace());
+        const char* clearParam = req.url_params.get("clear");
+        if (clearParam && std::string(clearParam) == "true") clearTraceEvents();
+        res.set_header("Content-Type", "application/json");
+        return res;
+    });
 
+    // Admin: the most recent slow-query log entries, oldest first
+    CROW_ROUTE(app, "/api/admin/slow-queries")([](const crow::request& req) -> crow::response {
+        if (!adminAllowed(req)) return adminForbidden();
         json response;
-        response["results"] = json::array();
-        for (const auto& p : results) {
-            auto jobJson = jobToJson(jobs[p.second], p.second);
-            jobJson["score"] = p.first;
-            response["results"].push_back(jobJson);
+        response["thresholdMicros"] = slowQueryLog.threshold();
+        response["logged"] = slowQueryLog.logged();
+        response["dropped"] = slowQueryLog.dropped();
+        response["recent"] = json::parse(slowQueryLog.recentJson());
+        return crow::response(response.dump());
+    });
+
+    // API: Job title autocomplete (Trie prefix search)
+    CROW_ROUTE(app, "/api/autocomplete")([](const crow::request& req) -> crow::response {
+        const char* prefix = req.url_params.get("prefix");
+        json response;
+        response["suggestions"] = json::array();
+        if (prefix && *prefix) {
+            std::shared_lock<std::shared_mutex> lock(catalogMutex);
+            std::vector<std::string> titles = jobTitleTrie.searchPrefix(prefix);
+            lock.unlock();
+            std::sort(titles.begin(), titles.end());
+            if (titles.size() > 10) titles.resize(10);
+            response["suggestions"] = titles;
         }
+        return crow::response(response.dump());
+    });
 
+    // API: Skills the co-occurrence embeddings place closest to a skill
+    CROW_ROUTE(app, "/api/skills/similar")([](const crow::request& req) -> crow::response {
+        const char* skill = req.url_params.get("skill");
+        const char* limitParam = req.url_params.get("limit");
+        size_t limit = std::min<size_t>(limitParam ? std::strtoul(limitParam, nullptr, 10) : 10, 100);
+        json response;
+        response["skill"] = skill ? skill : "";
+        response["similar"] = json::array();
+        if (skill && *skill) {
+            std::shared_lock<std::shared_mutex> lock(catalogMutex);
+            uint32_t skillId = skillNames.find(toLower(skill));
+            if (skillId != StringInterner::NotFound) {
+                for (const auto& [other, similarity] : skillEmbeddings.nearest(skillId, limit, 0.0f)) {
+                    response["similar"].push_back({{"skill", skillNames.str(other)}, {"similarity", std::round(similarity * 1000.0) / 1000}});
+                }
+            }
+        }
         return crow::response(response.dump());
     });
 
+    // API: Jobs whose skill vectors are nearest to a job's (approximate, HNSW)
+    CROW_ROUTE(app, "/api/jobs/<int>/similar")([](const crow::request& req, int jobId) -> crow::response {
+        TRACE_SPAN("GET /api/jobs/<int>/similar");
+        const char* limitParam = req.url_params.get("limit");
+        size_t limit = std::min<size_t>(limitParam ? std::strtoul(limitParam, nullptr, 10) : 10, 100);
+        std::shared_lock<std::shared_mutex> lock(catalogMutex);
+        if (jobId < 0 || (size_t)jobId >= jobs.size()) {
+            json error;
+            error["success"] = false;
+            error["message"] = "Job not found";
+            return crow::response(404, error.dump());
+        }
+        static ResponseSizeHint sizeHint(4096);
+        std::string body;
+        body.reserve(sizeHint.get());
+        JsonWriter out(body);
+        out.beginObject();
+        out.key("jobId");
+        out.integer(jobId);
+        out.key("similar");
+        writeJobs(out, jobVectors.similarJobs(jobId, limit), [](const auto& hit) { return hit.first; }, [](JsonWriter& out, const auto& hit) {
+            out.key("similarity");
+            out.number(std::round(hit.second * 1000.0) / 1000);
+        });
+        out.endObject();
+        lock.unlock();
+        sizeHint.update(body.size());
+        return crow::response(std::move(body));
+    });
+
+    // API: Jobs within radiusKm (default 50) of a place, nearest first; places come from the gazetteer
+    CROW_ROUTE(app, "/api/jobs/near")([](const crow::request& req) -> crow::response {
+        TRACE_SPAN("GET /api/jobs/near");
+        const char* location = req.url_params.get("location");
+        const char* radiusParam = req.url_params.get("radiusKm");
+        const char* limitParam = req.url_params.get("limit");
+        double radiusKm = std::min(radiusParam ? std::max(0.0, std::strtod(radiusParam, nullptr)) : 50.0, 20000.0);
+        size_t limit = std::min<size_t>(limitParam ? std::strtoul(limitParam, nullptr, 10) : 20, 100);
+        uint32_t center = location ? gazetteer.resolve(location) : Gazetteer::NoPlace;
+        if (center == Gazetteer::NoPlace) {
+            json error;
+            error["success"] = false;
+            error["message"] = location && *location ? "Unknown location" : "Missing location";
+            return crow::response(location && *location ? 404 : 400, error.dump());
+        }
+
+        // The grid narrows the places to check; jobs are then read per place, nearest place first
+        const Place& origin = gazetteer.place(center);
+        std::vector<std::pair<double, uint32_t>> nearby;
+        for (uint32_t placeId : gazetteer.within(center, radiusKm)) {
+            const Place& place = gazetteer.place(placeId);
+            nearby.emplace_back(haversineKm(origin.lat, origin.lon, place.lat, place.lon), placeId);
+        }
+        std::sort(nearby.begin(), nearby.end());
+
+        static ResponseSizeHint sizeHint(4096);
+        std::string body;
+        body.reserve(sizeHint.get());
+        JsonWriter out(body);
+        out.beginObject();
+        out.key("location");
+        out.string(origin.name);
+        out.key("radiusKm");
+        out.number(radiusKm);
+        out.key("results");
+        std::shared_lock<std::shared_mutex> lock(catalogMutex);
+        std::vector<std::pair<int, double>> found; // Job, distance
+        for (const auto& [distance, placeId] : nearby) {
+            for (int jobId : placeJobs[placeId]) {
+                if (found.size() >= limit) break;
+                found.emplace_back(jobId, distance);
+            }
+        }
+        writeJobs(out, found, [](const auto& hit) { return hit.first; }, [](JsonWriter& out, const auto& hit) {
+            out.key("distanceKm");
+            out.number(std::round(hit.second * 10.0) / 10);
+        });
+        lock.unlock();
+        out.endObject();
+        sizeHint.update(body.size());
+        return crow::response(std::move(body));
+    });
+
     // API: Update candidate profile
     CROW_ROUTE(app, "/api/profile")
     .methods("POST"_method)([](const crow::request& req) -> crow::response {
         try {
-            auto body = json::parse(req.body);
-            std::string sessionId = body.value("sessionId", "default");
-            
-            Candidate& candidate = candidates[sessionId];
-            candidate.name = body["name"].get<std::string>();
-            candidate.preferredLocation = body["location"].get<std::string>();
-            candidate.expectedSalary = body["salary"].get<double>();
-            candidate.skills.clear();
-            for (const auto& skill : body["skills"]) {
-                candidate.skills.push_back(skill.get<std::string>());
-            }
+            std::string sessionId;
+            Candidate candidate = candidateFromJsonText(req.body, sessionId);
+            candidate.radiusKm = std::max(0.0, candidate.radiusKm);
             candidate.isProfileSet = true;
+            {
+                // Fill from the skill matrix and subscribe atomically with respect to ingest
+                std::shared_lock<std::shared_mutex> lock(catalogMutex);
+                candidate.recommendations = resolveProfile(candidate, skillNames, locationNames, skillEmbeddings, gazetteer);
+                extendRecommendations(*candidate.recommendations, jobs, skillMatrix, skillNames, locationNames);
+                recommendationSubscriptions.subscribe(candidate.recommendations);
+            }
+            {
+                // Charge the recommendations to the session, and keep charging as ingest appends to them
+                std::shared_ptr<RecommendationState> state = candidate.recommendations;
+                std::lock_guard<std::mutex> stateLock(state->mutex);
+                state->onResize = [sessionId, recommendations = state.get()](size_t bytes) {
+                    candidates.resize(sessionId, recommendations, bytes);
+                };
+                state->reportedBytes = recommendationBytes(*state);
+                candidates.put(sessionId, std::move(candidate), state->reportedBytes);
+            }
 
             json response;
             response["success"] = true;
@@ -174,44 +908,240 @@ int main() {
 
     // API: Get job recommendations
     CROW_ROUTE(app, "/api/recommendations")( [](const crow::request& req) -> crow::response {
+        TRACE_SPAN("GET /api/recommendations");
+        QueryPlan plan("/api/recommendations");
         const char* sessionParam = req.url_params.get("sessionId");
         std::string sessionId = sessionParam ? std::string(sessionParam) : std::string("default");
 
-        if (candidates.find(sessionId) == candidates.end() || !candidates[sessionId].isProfileSet) {
+        std::shared_ptr<const Candidate> profile = candidates.get(sessionId);
+        if (!profile || !profile->isProfileSet) {
             json error;
             error["success"] = false;
             error["message"] = "Profile not set. Please create your profile first.";
             return crow::response(400, error.dump());
         }
 
-        const Candidate& candidate = candidates[sessionId];
-        std::unordered_map<int, int> jobMatchScores;
-        
-        for (const auto& skill : candidate.skills) {
-            auto it = skillIndex.find(toLower(skill));
-            if (it != skillIndex.end()) {
-                for (int jobIndex : it->second) {
-                    jobMatchScores[jobIndex]++;
-                }
+        // Ingest appends matching jobs to the profile's materialized list, so a JSON poll is just a read.
+        // The pre-rendered list is JSON; other formats re-render the matches from the catalog.
+        WireFormat format = negotiateFormat(req.get_header_value("Accept"));
+        const Candidate& candidate = *profile;
+        RecommendationState& state = *candidate.recommendations;
+        std::shared_lock<std::shared_mutex> catalogLock(catalogMutex, std::defer_lock);
+        if (format != WireFormat::Json) catalogLock.lock(); // Before the state's mutex, as ingest takes them
+        std::lock_guard<std::mutex> stateLock(state.mutex);
+        plan.endPhase("session_lookup");
+        plan.candidateSkills = state.skillIds.size() + state.pendingSkills.size();
+        plan.results = state.matches.size();
+        std::string body;
+        if (format == WireFormat::Json) {
+            body.reserve(state.rendered.size() + 24);
+            body += "{\"recommendations\":[";
+            body += state.rendered;
+            body += "]}";
+        } else {
+            body = renderAs(format, state.rendered.size() / 2, [&](auto& out) {
+                out.beginObject();
+                out.key("recommendations");
+                out.beginArray();
+                for (const RecommendationMatch& match : state.matches) writeMatch(out, jobs[match.jobId], match);
+                out.endArray();
+                out.endObject();
+            });
+        }
+        plan.endPhase("dump");
+
+        if (slowQueryLog.isSlow(plan.finish())) {
+            std::vector<std::string> skills;
+            for (const auto& skill : candidate.skills) skills.push_back(toLower(skill));
+            std::sort(skills.begin(), skills.end());
+            std::ostringstream query;
+            query << "skills=";
+            for (size_t i = 0; i < skills.size(); ++i) query << (i ? "," : "") << skills[i];
+            query << " location=" << toLower(candidate.preferredLocation) << " radiusKm=" << candidate.radiusKm << " minSalary=" << candidate.expectedSalary;
+            plan.query = query.str();
+            slowQueryLog.submit(std::move(plan));
+        }
+        return withFormat(crow::response(std::move(body)), format);
+    });
+
+    // API: Jobs nearest to the profile's skill vector that meet its location and salary (approximate, HNSW)
+    CROW_ROUTE(app, "/api/recommendations/vector")([](const crow::request& req) -> crow::response {
+        TRACE_SPAN("GET /api/recommendations/vector");
+        const char* sessionParam = req.url_params.get("sessionId");
+        const char* limitParam = req.url_params.get("limit");
+        size_t limit = std::min<size_t>(limitParam ? std::strtoul(limitParam, nullptr, 10) : 10, 100);
+        std::shared_ptr<const Candidate> profile = candidates.get(sessionParam ? sessionParam : "default");
+        if (!profile || !profile->isProfileSet) {
+            json error;
+            error["success"] = false;
+            error["message"] = "Profile not set. Please create your profile first.";
+            return crow::response(400, error.dump());
+        }
+
+        std::vector<std::pair<int, float>> nearest; // Job, similarity
+        std::shared_lock<std::shared_mutex> lock(catalogMutex);
+        std::vector<uint32_t> skillIds;
+        for (const auto& skill : profile->skills) {
+            uint32_t id = skillNames.find(toLower(skill));
+            if (id != StringInterner::NotFound) skillIds.push_back(id);
+        }
+        std::sort(skillIds.begin(), skillIds.end());
+        skillIds.erase(std::unique(skillIds.begin(), skillIds.end()), skillIds.end());
+        float query[SkillEmbeddings::Dim];
+        if (JobVectorIndex::skillSetVector(skillIds, skillEmbeddings, query)) {
+            LocationPreference where = resolveLocationPreference(profile->preferredLocation, profile->radiusKm, locationNames, gazetteer);
+            if (where.acceptsAll() || where.locationId != StringInterner::NotFound || !where.places.empty()) {
+                auto accept = [&](int jobId) {
+                    const Job& job = jobs[jobId];
+                    return job.salary >= profile->expectedSalary && where.accepts(job);
+                };
+                nearest = jobVectors.nearestJobs(query, limit, accept);
             }
         }
+        static ResponseSizeHint sizeHint(4096);
+        WireFormat format = negotiateFormat(req.get_header_value("Accept"));
+        std::string body = renderAs(format, sizeHint.get(), [&](auto& out) {
+            out.beginObject();
+            out.key("recommendations");
+            writeJobs(out, nearest, [](const auto& hit) { return hit.first; }, [](auto& out, const auto& hit) {
+                out.key("similarity");
+                out.number(std::round(hit.second * 1000.0) / 1000);
+            });
+            out.endObject();
+        });
+        lock.unlock();
+        sizeHint.update(body.size());
+        return withFormat(crow::response(std::move(body)), format);
+    });
 
-        json response;
-        response["recommendations"] = json::array();
-        
-        for (const auto& [jobIndex, matchCount] : jobMatchScores) {
-            const Job& job = jobs[jobIndex];
-            if (job.salary >= candidate.expectedSalary) {
-                if (candidate.preferredLocation.empty() || 
-                    toLower(job.location) == toLower(candidate.preferredLocation)) {
-                    auto jobJson = jobToJson(job, jobIndex);
-                    jobJson["matchedSkills"] = matchCount;
-                    response["recommendations"].push_back(jobJson);
+    // API: Top-K recommendations for many stored sessions in one call, e.g. for nightly matching
+    CROW_ROUTE(app, "/api/recommendations/batch")
+    .methods("POST"_method)([](const crow::request& req) -> crow::response {
+        TRACE_SPAN("POST /api/recommendations/batch");
+        const size_t MaxBatch = 10000;
+        try {
+            auto body = json::parse(req.body);
+            size_t K = std::min<size_t>(body.value("k", 10), 100);
+            std::vector<std::string> sessionIds;
+            for (const auto& id : body["sessionIds"]) sessionIds.push_back(id.get<std::string>());
+            if (sessionIds.size() > MaxBatch) throw std::invalid_argument("At most 10000 sessionIds per batch");
+
+            std::vector<std::string> found, missing;
+            std::vector<Candidate> profiles;
+            for (const auto& sessionId : sessionIds) {
+                std::shared_ptr<const Candidate> profile = candidates.get(sessionId);
+                if (profile && profile->isProfileSet) {
+                    found.push_back(sessionId);
+                    profiles.push_back(*profile);
+                } else {
+                    missing.push_back(sessionId);
                 }
             }
+
+            static ResponseSizeHint sizeHint(1 << 16);
+            WireFormat format = negotiateFormat(req.get_header_value("Accept"));
+            std::shared_lock<std::shared_mutex> lock(catalogMutex);
+            auto top = recommendJobsBatch(jobs, skillMatrix, skillNames, locationNames, skillEmbeddings, gazetteer, profiles, K, &recommendPool);
+            // Copy out the recommended jobs, each once, so rendering does not hold up ingest
+            std::vector<int> jobIds;
+            for (const auto& scoredJobs : top) {
+                for (const ScoredJob& scored : scoredJobs) jobIds.push_back(scored.jobIndex);
+            }
+            std::sort(jobIds.begin(), jobIds.end());
+            jobIds.erase(std::unique(jobIds.begin(), jobIds.end()), jobIds.end());
+            std::vector<Job> recommended;
+            recommended.reserve(jobIds.size());
+            for (int jobId : jobIds) recommended.push_back(jobs[jobId]);
+            lock.unlock();
+
+            std::string response = renderAs(format, sizeHint.get(), [&](auto& out) {
+                out.beginObject();
+                out.key("results");
+                out.beginArray();
+                for (size_t i = 0; i < found.size(); ++i) {
+                    out.beginObject();
+                    out.key("sessionId");
+                    out.string(found[i]);
+                    out.key("recommendations");
+                    out.beginArray();
+                    for (const ScoredJob& scored : top[i]) {
+                        size_t copy = std::lower_bound(jobIds.begin(), jobIds.end(), scored.jobIndex) - jobIds.begin();
+                        out.beginObject();
+                        writeJobFields(out, recommended[copy], scored.jobIndex);
+                        out.key("matchedSkills");
+                        out.integer(scored.matchedSkills);
+                        out.key("similarSkills");
+                        out.integer(scored.similarSkills);
+                        out.key("skillScore");
+                        out.number(std::round(scored.skillScore * 100.0) / 100);
+                        out.endObject();
+                    }
+                    out.endArray();
+                    out.endObject();
+                }
+                out.endArray();
+                out.key("missing");
+                out.beginArray();
+                for (const auto& sessionId : missing) out.string(sessionId);
+                out.endArray();
+                out.endObject();
+            });
+            sizeHint.update(response.size());
+            return withFormat(crow::response(std::move(response)), format);
+        } catch (const std::exception& e) {
+            json error;
+            error["success"] = false;
+            error["message"] = e.what();
+            return crow::response(400, error.dump());
         }
+    });
 
-        return crow::response(response.dump());
+    // Push channel: after {"sessionId": "..."} the connection receives batches of newly posted
+    // jobs matching that profile, and acknowledges each with {"ack": <batch>}
+    CROW_ROUTE(app, "/ws/recommendations")
+    .websocket()
+    .onmessage([](crow::websocket::connection& conn, const std::string& data, bool /*isBinary*/) {
+        try {
+            auto message = json::parse(data);
+            if (message.contains("ack")) {
+                pushHub.ack(&conn, message["ack"].get<uint64_t>());
+                return;
+            }
+            std::string sessionId = message.value("sessionId", "default");
+            std::shared_ptr<const Candidate> profile = candidates.get(sessionId);
+            if (!profile || !profile->isProfileSet) {
+                json error;
+                error["type"] = "error";
+                error["message"] = "Profile not set. Please create your profile first.";
+                conn.send_text(error.dump());
+                return;
+            }
+
+            // Matches appended after this point are pushed; earlier ones come from /api/recommendations
+            auto subscriber = pushHub.open(
+                &conn, [&conn](std::function<void()> handler) { conn.post(std::move(handler)); },
+                [&conn](const std::string& batch) { conn.send_text(batch); });
+            RecommendationState& state = *profile->recommendations;
+            size_t known;
+            {
+                std::lock_guard<std::mutex> stateLock(state.mutex);
+                state.listeners.push_back(subscriber);
+                known = state.matches.size();
+            }
+            json response;
+            response["type"] = "subscribed";
+            response["sessionId"] = sessionId;
+            response["known"] = known;
+            conn.send_text(response.dump());
+        } catch (const std::exception& e) {
+            json error;
+            error["type"] = "error";
+            error["message"] = e.what();
+            conn.send_text(error.dump());
+        }
+    })
+    .onclose([](crow::websocket::connection& conn, const std::string& /*reason*/) {
+        pushHub.close(&conn);
     });
 
     app.loglevel(crow::LogLevel::Warning);
@@ -0,0 +1,214 @@
+#include "metrics.h"
+#include <algorithm>
+#include <cctype>
+#include <iomanip>
+#include <sstream>
+
+// --- LatencyHistogram ---
+
+size_t LatencyHistogram::bucketFor(uint64_t micros) {
+    if (micros < SubBuckets) return micros;
+    int msb = 63 - __builtin_clzll(micros);
+    size_t sub = (micros >> (msb - SubBucketBits)) & (SubBuckets - 1);
+    size_t bucket = (msb - SubBucketBits + 1) * SubBuckets + sub;
+    return std::min(bucket, BucketCount - 1);
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t bucket) {
+    if (bucket < SubBuckets) return bucket;
+    int msb = bucket / SubBuckets + SubBucketBits - 1;
+    uint64_t sub = bucket % SubBuckets;
+    uint64_t width = 1ull << (msb - SubBucketBits);
+    return (SubBuckets + sub) * width + width - 1;
+}
+
+void LatencyHistogram::record(uint64_t micros) {
+    // Single writer per histogram: a relaxed load/store pair is enough and avoids a locked add
+    auto& bucket = buckets[bucketFor(micros)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::addTo(std::vector<uint64_t>& counts) const {
+    for (size_t i = 0; i < BucketCount; ++i) {
+        counts[i] += buckets[i].load(std::memory_order_relaxed);
+    }
+}
+
+uint64_t histogramQuantile(const std::vector<uint64_t>& counts, double q) {
+    uint64_t total = 0;
+    for (uint64_t c : counts) total += c;
+    if (total == 0) return 0;
+    uint64_t rank = std::max<uint64_t>(1, (uint64_t)(q * total + 0.5));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        seen += counts[i];
+        if (seen >= rank) return LatencyHistogram::bucketUpperBound(i);
+    }
+    return LatencyHistogram::bucketUpperBound(counts.size() - 1);
+}
+
+// --- RequestMetrics ---
+
+static std::vector<std::string> pathSegments(const std::string& path) {
+    std::vector<std::string> segments;
+    std::string segment;
+    std::istringstream stream(path);
+    while (std::getline(stream, segment, '/')) {
+        if (!segment.empty()) segments.push_back(segment);
+    }
+    return segments;
+}
+
+void RequestMetrics::addRoute(const std::string& method, const std::string& pattern) {
+    routes.push_back({method, pattern, pathSegments(pattern)});
+    if (pattern.find('<') == std::string::npos) {
+        exactRoutes[method + " " + pattern] = routes.size() - 1;
+    }
+}
+
+void RequestMetrics::addGauge(const std::string& name, const std::string& help, std::function<double()> read) {
+    scalars.push_back({name, help, "gauge", std::move(read)});
+}
+
+void RequestMetrics::addCounter(const std::string& name, const std::string& help, std::function<double()> read) {
+    scalars.push_back({name, help, "counter", std::move(read)});
+}
+
+size_t RequestMetrics::routeFor(const std::string& method, const std::string& url) const {
+    auto it = exactRoutes.find(method + " " + url);
+    if (it != exactRoutes.end()) return it->second;
+
+    std::vector<std::string> segments = pathSegments(url);
+    for (size_t r = 0; r < routes.size(); ++r) {
+        const Route& route = routes[r];
+        bool restOfPath = !route.segments.empty() && route.segments.back() == "<path>";
+        if (route.method != method) continue;
+        if (restOfPath ? segments.size() < route.segments.size() : segments.size() != route.segments.size()) continue;
+        bool match = true;
+        for (size_t i = 0; i < route.segments.size() - restOfPath && match; ++i) {
+            if (route.segments[i] == "<int>") {
+                match = !segments[i].empty() &&
+                        std::all_of(segments[i].begin(), segments[i].end(), [](unsigned char c) { return std::isdigit(c); });
+            } else {
+                match = route.segments[i] == segments[i];
+            }
+        }
+        if (match) return r;
+    }
+    return routes.size(); // "other"
+}
+
+RequestMetrics::ThreadSlot& RequestMetrics::localSlot() {
+    thread_local const RequestMetrics* owner = nullptr;
+    thread_local ThreadSlot* slot = nullptr;
+    if (owner != this) {
+        auto created = std::make_shared<ThreadSlot>();
+        created->routes.reset(new RouteCounters[routes.size() + 1]);
+        std::lock_guard<std::mutex> lock(registryMutex);
+        slots.push_back(created);
+        owner = this;
+        slot = created.get();
+    }
+    return *slot;
+}
+
+void RequestMetrics::record(const std::string& method, const std::string& url, int status, size_t responseBytes, uint64_t micros) {
+    RouteCounters& counters = localSlot().routes[routeFor(method, url)];
+    auto bump = [](std::atomic<uint64_t>& counter, uint64_t amount) {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    };
+    int statusClass = (status >= 100 && status < 600) ? status / 100 : 0;
+    bump(counters.byStatusClass[statusClass], 1);
+    bump(counters.responseBytes, responseBytes);
+    bump(counters.latencySumMicros, micros);
+    counters.latency.record(micros);
+}
+
+std::string RequestMetrics::render() const {
+    struct Totals {
+        std::array<uint64_t, 6> byStatusClass{};
+        uint64_t responseBytes = 0, latencySumMicros = 0;
+        std::vector<uint64_t> latency = std::vector<uint64_t>(LatencyHistogram::BucketCount, 0);
+    };
+    std::vector<Totals> totals(routes.size() + 1);
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (const auto& slot : slots) {
+            for (size_t r = 0; r < totals.size(); ++r) {
+                const RouteCounters& counters = slot->routes[r];
+                for (size_t c = 0; c < 6; ++c) totals[r].byStatusClass[c] += counters.byStatusClass[c].load(std::memory_order_relaxed);
+                totals[r].responseBytes += counters.responseBytes.load(std::memory_order_relaxed);
+                totals[r].latencySumMicros += counters.latencySumMicros.load(std::memory_order_relaxed);
+                counters.latency.addTo(totals[r].latency);
+            }
+        }
+    }
+
+    std::ostringstream out;
+    out << std::setprecision(12);
+    auto labels = [&](size_t r) {
+        return r < routes.size() ? "method=\"" + routes[r].method + "\",route=\"" + routes[r].pattern + "\""
+                                 : std::string("method=\"\",route=\"other\"");
+    };
+    auto requestCount = [](const Totals& t) {
+        uint64_t n = 0;
+        for (uint64_t c : t.byStatusClass) n += c;
+        return n;
+    };
+
+    out << "# HELP job_portal_http_requests_total Requests served, by route and status class.\n"
+        << "# TYPE job_portal_http_requests_total counter\n";
+    for (size_t r = 0; r < totals.size(); ++r) {
+        for (size_t c = 0; c < 6; ++c) {
+            if (totals[r].byStatusClass[c] == 0) continue;
+            std::string code = c == 0 ? "unknown" : std::to_string(c) + "xx";
+            out << "job_portal_http_requests_total{" << labels(r) << ",code=\"" << code << "\"} " << totals[r].byStatusClass[c] << "\n";
+        }
+    }
+
+    out << "# HELP job_portal_http_response_bytes_total Response body bytes sent, by route.\n"
+        << "# TYPE job_portal_http_response_bytes_total counter\n";
+    for (size_t r = 0; r < totals.size(); ++r) {
+        if (requestCount(totals[r]) == 0) continue;
+        out << "job_portal_http_response_bytes_total{" << labels(r) << "} " << totals[r].responseBytes << "\n";
+    }
+
+    // Fixed le boundaries (seconds) summed from the fine buckets, so every scrape has the same series
+    static const double bounds[] = {0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10};
+    out << "# HELP job_portal_http_request_duration_seconds Request latency, by route.\n"
+        << "# TYPE job_portal_http_request_duration_seconds histogram\n";
+    for (size_t r = 0; r < totals.size(); ++r) {
+        uint64_t count = requestCount(totals[r]);
+        if (count == 0) continue;
+        const auto& latency = totals[r].latency;
+        size_t bucket = 0;
+        uint64_t cumulative = 0;
+        for (double bound : bounds) {
+            uint64_t boundMicros = (uint64_t)(bound * 1e6);
+            while (bucket < latency.size() && LatencyHistogram::bucketUpperBound(bucket) <= boundMicros) {
+                cumulative += latency[bucket++];
+            }
+            out << "job_portal_http_request_duration_seconds_bucket{" << labels(r) << ",le=\"" << bound << "\"} " << cumulative << "\n";
+        }
+        out << "job_portal_http_request_duration_seconds_bucket{" << labels(r) << ",le=\"+Inf\"} " << count << "\n";
+        out << "job_portal_http_request_duration_seconds_sum{" << labels(r) << "} " << totals[r].latencySumMicros / 1e6 << "\n";
+        out << "job_portal_http_request_duration_seconds_count{" << labels(r) << "} " << count << "\n";
+    }
+
+    out << "# HELP job_portal_http_request_duration_quantile_seconds Latency quantiles from the full-resolution histogram.\n"
+        << "# TYPE job_portal_http_request_duration_quantile_seconds gauge\n";
+    for (size_t r = 0; r < totals.size(); ++r) {
+        if (requestCount(totals[r]) == 0) continue;
+        for (double q : {0.5, 0.9, 0.99, 0.999}) {
+            out << "job_portal_http_request_duration_quantile_seconds{" << labels(r) << ",quantile=\"" << q << "\"} "
+                << histogramQuantile(totals[r].latency, q) / 1e6 << "\n";
+        }
+    }
+
+    for (const auto& scalar : scalars) {
+        out << "# HELP " << scalar.name << " " << scalar.help << "\n"
+            << "# TYPE " << scalar.name << " " << scalar.type << "\n"
+            << scalar.name << " " << scalar.read() << "\n";
+    }
+    return out.str();
+}
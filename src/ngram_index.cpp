@@ -0,0 +1,57 @@
+#include "ngram_index.h"
+#include "job_portal.h"
+#include <algorithm>
+#include <numeric>
+
+static uint32_t packTrigram(const std::string& s, size_t i) {
+    return (uint32_t)(unsigned char)s[i] << 16 | (uint32_t)(unsigned char)s[i + 1] << 8 | (unsigned char)s[i + 2];
+}
+
+void NgramIndex::addField(int jobId, const std::string& lowerText) {
+    for (size_t i = 0; i + N <= lowerText.size(); ++i) {
+        std::vector<int>& list = postings[packTrigram(lowerText, i)];
+        if (list.empty() || list.back() != jobId) list.push_back(jobId);
+    }
+}
+
+void NgramIndex::addJob(int jobId, const Job& job) {
+    addField(jobId, toLower(job.title));
+    for (const auto& skill : job.skills) {
+        addField(jobId, toLower(skill));
+    }
+    jobCount = std::max(jobCount, jobId + 1);
+}
+
+std::vector<int> NgramIndex::candidates(const std::string& keyword, size_t* postingsTouched) const {
+    std::string lowerKeyword = toLower(keyword);
+    if (lowerKeyword.size() < N) {
+        if (postingsTouched) *postingsTouched += jobCount;
+        std::vector<int> all(jobCount);
+        std::iota(all.begin(), all.end(), 0);
+        return all;
+    }
+
+    std::vector<const std::vector<int>*> lists;
+    for (size_t i = 0; i + N <= lowerKeyword.size(); ++i) {
+        auto it = postings.find(packTrigram(lowerKeyword, i));
+        if (it == postings.end()) return {}; // A trigram no job has: nothing can match
+        lists.push_back(&it->second);
+    }
+    // Intersect shortest first so the working set only shrinks
+    std::sort(lists.begin(), lists.end(), [](auto* a, auto* b) {
+        return a->size() != b->size() ? a->size() < b->size() : a < b;
+    });
+    lists.erase(std::unique(lists.begin(), lists.end()), lists.end());
+    if (postingsTouched) {
+        for (auto* list : lists) *postingsTouched += list->size();
+    }
+
+    std::vector<int> result = *lists[0];
+    std::vector<int> next;
+    for (size_t i = 1; i < lists.size() && !result.empty(); ++i) {
+        next.clear();
+        std::set_intersection(result.begin(), result.end(), lists[i]->begin(), lists[i]->end(), std::back_inserter(next));
+        result.swap(next);
+    }
+    return result;
+}
@@ -0,0 +1,105 @@
+#include "push_hub.h"
+
+void PushSubscriber::onMatch(const std::string& renderedMatch) {
+    std::lock_guard<std::mutex> lock(mutex);
+    queue.push_back(renderedMatch);
+    queuedBytes += renderedMatch.size();
+    while (queuedBytes > maxQueuedBytes && !queue.empty()) {
+        queuedBytes -= queue.front().size();
+        queue.pop_front();
+        dropped++;
+    }
+}
+
+PushHub::PushHub(Limits limits) : limits(limits), flusher(&PushHub::flushLoop, this) {}
+
+PushHub::~PushHub() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    flusher.join();
+}
+
+std::shared_ptr<PushSubscriber> PushHub::open(const void* connection, PushSubscriber::Poster post, PushSubscriber::Sender send) {
+    auto subscriber = std::make_shared<PushSubscriber>(std::move(post), std::move(send), limits.maxQueuedBytes);
+    std::lock_guard<std::mutex> lock(mutex);
+    connections[connection] = subscriber; // Re-subscribing replaces the old subscription
+    return subscriber;
+}
+
+void PushHub::ack(const void* connection, uint64_t batch) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = connections.find(connection);
+    if (it == connections.end()) return;
+    PushSubscriber& subscriber = *it->second;
+    std::lock_guard<std::mutex> subscriberLock(subscriber.mutex);
+    if (batch <= subscriber.lastBatch && batch > subscriber.lastAcked) subscriber.lastAcked = batch;
+}
+
+void PushHub::close(const void* connection) {
+    std::lock_guard<std::mutex> lock(mutex);
+    connections.erase(connection);
+}
+
+PushHub::Stats PushHub::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    Stats s{};
+    s.connections = connections.size();
+    for (const auto& [connection, subscriber] : connections) {
+        std::lock_guard<std::mutex> subscriberLock(subscriber->mutex);
+        s.queuedBytes += subscriber->queuedBytes;
+    }
+    s.dropped = droppedTotal;
+    s.batches = batchesTotal;
+    return s;
+}
+
+void PushHub::flush(const void* connection, const std::shared_ptr<PushSubscriber>& shared) {
+    PushSubscriber& subscriber = *shared;
+    std::string message;
+    {
+        std::lock_guard<std::mutex> lock(subscriber.mutex);
+        if (subscriber.queue.empty() && subscriber.dropped == 0) return;
+        if (subscriber.lastBatch - subscriber.lastAcked >= limits.maxInFlight) return; // Client is behind
+
+        message = "{\"type\":\"jobs\",\"batch\":" + std::to_string(++subscriber.lastBatch) + ",\"dropped\":" +
+                  std::to_string(subscriber.dropped) + ",\"jobs\":[";
+        for (size_t i = 0; i < limits.maxBatchItems && !subscriber.queue.empty(); ++i) {
+            if (i) message += ',';
+            message += subscriber.queue.front();
+            subscriber.queuedBytes -= subscriber.queue.front().size();
+            subscriber.queue.pop_front();
+        }
+        message += "]}";
+        droppedTotal += subscriber.dropped;
+        subscriber.dropped = 0;
+    }
+    batchesTotal++;
+    // The connection may be closed and freed before the handler runs, but only on the thread that
+    // runs it, so checking there that this subscription is still the open one makes the send safe.
+    // Comparing subscribers, not just addresses, skips a new connection allocated at the same address.
+    std::weak_ptr<PushSubscriber> weak = shared;
+    subscriber.post([this, connection, weak, message = std::move(message)] {
+        auto live = weak.lock();
+        if (!live) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = connections.find(connection);
+            if (it == connections.end() || it->second != live) return;
+        }
+        live->send(message);
+    });
+}
+
+void PushHub::flushLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        wake.wait_for(lock, limits.batchInterval);
+        if (stopping) break;
+        for (auto& [connection, subscriber] : connections) {
+            flush(connection, subscriber); // Posting needs the connection alive; close() waits on the mutex
+        }
+    }
+}
@@ -0,0 +1,128 @@
+#include "query_cache.h"
+#include <algorithm>
+#include <functional>
+
+// --- FrequencySketch ---
+
+FrequencySketch::FrequencySketch(size_t capacity)
+    : width(std::max<size_t>(64, capacity)), sampleSize(10 * std::max<size_t>(64, capacity)) {
+    table.assign(Depth * width, 0);
+}
+
+size_t FrequencySketch::slot(size_t hash, int row) const {
+    // Derive one index per row from a single hash (Kirsch-Mitzenmacher)
+    size_t h = hash + row * ((hash >> 32) | 1) * 0x9E3779B97F4A7C15ull;
+    return row * width + (h >> 7) % width;
+}
+
+void FrequencySketch::increment(size_t hash) {
+    for (int row = 0; row < Depth; ++row) {
+        uint8_t& counter = table[slot(hash, row)];
+        if (counter < MaxCount) counter++;
+    }
+    if (++additions >= sampleSize) {
+        for (auto& counter : table) counter >>= 1; // Age: halve every counter
+        additions /= 2;
+    }
+}
+
+int FrequencySketch::estimate(size_t hash) const {
+    int result = MaxCount;
+    for (int row = 0; row < Depth; ++row) {
+        result = std::min<int>(result, table[slot(hash, row)]);
+    }
+    return result;
+}
+
+// --- QueryCache ---
+
+QueryCache::QueryCache(size_t capacity, size_t shardCount)
+    : shardCapacity(std::max<size_t>(1, capacity / std::max<size_t>(1, shardCount))) {
+    for (size_t i = 0; i < std::max<size_t>(1, shardCount); ++i) {
+        shards.push_back(std::make_unique<Shard>(shardCapacity));
+    }
+}
+
+bool QueryCache::get(const std::string& key, uint64_t generation, std::string& value) {
+    size_t hash = std::hash<std::string>{}(key);
+    Shard& shard = shardFor(hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.sketch.increment(hash); // Count misses too, so popular keys earn admission
+
+    auto it = shard.map.find(key);
+    if (it == shard.map.end()) {
+        misses++;
+        return false;
+    }
+    if (it->second->generation != generation) {
+        shard.lru.erase(it->second);
+        shard.map.erase(it);
+        stale++;
+        misses++;
+        return false;
+    }
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    value = it->second->value;
+    hits++;
+    return true;
+}
+
+void QueryCache::put(const std::string& key, uint64_t generation, std::string value) {
+    size_t hash = std::hash<std::string>{}(key);
+    Shard& shard = shardFor(hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.map.find(key);
+    if (it != shard.map.end()) {
+        if (it->second->generation > generation) return; // A newer rendering won the race
+        it->second->generation = generation;
+        it->second->value = std::move(value);
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        return;
+    }
+
+    // Entries only become current by being rendered or refreshed, which moves them to the front,
+    // so every stale entry sits behind the current ones; drop those first, without admission
+    while (shard.map.size() >= shardCapacity && shard.lru.back().generation < generation) {
+        shard.map.erase(shard.lru.back().key);
+        shard.lru.pop_back();
+        stale++;
+    }
+    if (shard.map.size() >= shardCapacity) {
+        Entry& victim = shard.lru.back();
+        size_t victimHash = std::hash<std::string>{}(victim.key);
+        if (shard.sketch.estimate(hash) <= shard.sketch.estimate(victimHash)) {
+            rejections++;
+            return;
+        }
+        shard.map.erase(victim.key);
+        shard.lru.pop_back();
+        evictions++;
+    }
+
+    shard.lru.push_front({key, generation, std::move(value)});
+    shard.map[key] = shard.lru.begin();
+    insertions++;
+}
+
+void QueryCache::recordLatency(bool hit, std::chrono::nanoseconds elapsed) {
+    (hit ? hitNanos : missNanos) += elapsed.count();
+    (hit ? timedHits : timedMisses)++;
+}
+
+QueryCache::Stats QueryCache::stats() const {
+    Stats s{};
+    s.hits = hits;
+    s.misses = misses;
+    s.stale = stale;
+    s.insertions = insertions;
+    s.evictions = evictions;
+    s.rejections = rejections;
+    for (const auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        s.entries += shard->map.size();
+    }
+    s.avgHitMicros = timedHits ? hitNanos / 1000.0 / timedHits : 0.0;
+    s.avgMissMicros = timedMisses ? missNanos / 1000.0 / timedMisses : 0.0;
+    return s;
+}
@@ -0,0 +1,205 @@
+#include "recommendations.h"
+#include "job_json.h"
+#include "job_portal.h"
+#include "json_writer.h"
+#include <algorithm>
+#include <cmath>
+
+// Appends jobs[jobId] to the state's matches and rendered list
+static void appendMatch(RecommendationState& state, const Job& job, int jobId, const SkillOverlap& overlap) {
+    RecommendationMatch match{jobId, overlap.exact, overlap.similar, overlap.score};
+    std::string rendered;
+    JsonWriter out(rendered);
+    writeMatch(out, job, match);
+    state.matches.push_back(match);
+    if (!state.rendered.empty()) state.rendered += ',';
+    state.rendered += rendered;
+    // Capacities grow geometrically, so this reports O(log matches) times per state
+    if (state.onResize) {
+        size_t bytes = recommendationBytes(state);
+        if (bytes != state.reportedBytes) state.onResize(state.reportedBytes = bytes);
+    }
+
+    for (size_t i = 0; i < state.listeners.size();) {
+        if (auto listener = state.listeners[i].lock()) {
+            listener->onMatch(rendered);
+            ++i;
+        } else { // Connection closed
+            state.listeners[i] = std::move(state.listeners.back());
+            state.listeners.pop_back();
+        }
+    }
+}
+
+static bool acceptsJob(const RecommendationState& state, const Job& job) {
+    return job.salary >= state.minSalary && state.where.accepts(job);
+}
+
+std::shared_ptr<RecommendationState> resolveProfile(const Candidate& candidate, const StringInterner& skillNames,
+                                                    const StringInterner& locationNames, const SkillEmbeddings& embeddings,
+                                                    const Gazetteer& gazetteer) {
+    auto state = std::make_shared<RecommendationState>();
+    for (const auto& skill : candidate.skills) {
+        std::string lower = toLower(skill);
+        uint32_t id = skillNames.find(lower);
+        if (id != StringInterner::NotFound) {
+            state->skillIds.push_back(id);
+        } else {
+            state->pendingSkills.push_back(std::move(lower));
+        }
+    }
+    std::sort(state->skillIds.begin(), state->skillIds.end());
+    state->skillIds.erase(std::unique(state->skillIds.begin(), state->skillIds.end()), state->skillIds.end());
+    std::sort(state->pendingSkills.begin(), state->pendingSkills.end());
+    state->pendingSkills.erase(std::unique(state->pendingSkills.begin(), state->pendingSkills.end()), state->pendingSkills.end());
+    state->relatedSkills = embeddings.related(state->skillIds);
+
+    state->where = resolveLocationPreference(candidate.preferredLocation, candidate.radiusKm, locationNames, gazetteer);
+    state->minSalary = candidate.expectedSalary;
+    return state;
+}
+
+RecommendationDelta extendRecommendations(RecommendationState& state, const std::vector<Job>& jobs, const SkillMatrix& matrix,
+                                          const StringInterner& skillNames, const StringInterner& locationNames) {
+    RecommendationDelta delta;
+    delta.firstNew = state.matches.size();
+    if (state.jobsSeen >= jobs.size()) return delta;
+
+    // A skill first interned after the last update can only appear in jobs we have not seen yet
+    for (auto it = state.pendingSkills.begin(); it != state.pendingSkills.end();) {
+        uint32_t id = skillNames.find(*it);
+        if (id == StringInterner::NotFound) {
+            ++it;
+            continue;
+        }
+        state.skillIds.insert(std::upper_bound(state.skillIds.begin(), state.skillIds.end(), id), id);
+        it = state.pendingSkills.erase(it);
+    }
+    if (!state.where.acceptsAll() && state.where.locationId == StringInterner::NotFound) {
+        state.where.locationId = locationNames.find(state.where.location);
+    }
+
+    // Only the columns' tails past jobsSeen are visited; the product arrives in ascending job order
+    std::vector<std::vector<uint32_t>> row{state.skillIds};
+    for (const auto& related : state.relatedSkills) row[0].push_back(related.first);
+    std::sort(row[0].begin(), row[0].end());
+    delta.postingsTouched = matrix.multiply(row, state.jobsSeen, [&](size_t, int jobId, int) {
+        const Job& job = jobs[jobId];
+        delta.jobsScored++;
+        if (acceptsJob(state, job)) appendMatch(state, job, jobId, skillOverlap(job.skillIds, state.skillIds, state.relatedSkills));
+    });
+    state.jobsSeen = jobs.size();
+    return delta;
+}
+
+size_t recommendationBytes(const RecommendationState& state) {
+    size_t bytes = sizeof(RecommendationState) + state.where.location.capacity() + state.rendered.capacity();
+    bytes += state.where.places.capacity() * sizeof(uint32_t);
+    bytes += state.skillIds.capacity() * sizeof(uint32_t) + state.matches.capacity() * sizeof(RecommendationMatch);
+    bytes += state.relatedSkills.capacity() * sizeof(std::pair<uint32_t, float>);
+    for (const auto& skill : state.pendingSkills) bytes += sizeof(std::string) + skill.capacity();
+    return bytes;
+}
+
+// --- RecommendationSubscriptions ---
+
+void RecommendationSubscriptions::add(Subscribers& subscribers, const std::shared_ptr<RecommendationState>& state) {
+    // Prune dead entries whenever the list doubles, keeping it within twice its live size amortized
+    size_t size = subscribers.size();
+    if (size >= 64 && (size & (size - 1)) == 0) {
+        subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(), [](const auto& s) { return s.expired(); }),
+                          subscribers.end());
+    }
+    subscribers.push_back(state);
+}
+
+void RecommendationSubscriptions::subscribe(const std::shared_ptr<RecommendationState>& state) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (uint32_t skillId : state->skillIds) {
+        if (skillId >= bySkill.size()) bySkill.resize(skillId + 1);
+        add(bySkill[skillId], state);
+    }
+    for (const auto& [skillId, similarity] : state->relatedSkills) {
+        if (skillId >= bySkill.size()) bySkill.resize(skillId + 1);
+        add(bySkill[skillId], state);
+    }
+    for (const auto& name : state->pendingSkills) {
+        add(pending[name], state);
+    }
+    // Like add(): prune whenever the map doubles, keeping it within twice its live size amortized
+    if (pending.size() >= prunePendingAt) {
+        prunePending();
+        prunePendingAt = std::max<size_t>(64, pending.size() * 2);
+    }
+}
+
+void RecommendationSubscriptions::prunePending() {
+    for (auto it = pending.begin(); it != pending.end();) {
+        Subscribers& subscribers = it->second;
+        subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(), [](const auto& s) { return s.expired(); }),
+                          subscribers.end());
+        it = subscribers.empty() ? pending.erase(it) : std::next(it);
+    }
+}
+
+void RecommendationSubscriptions::promotePending(uint32_t skillId, const std::string& name) {
+    auto it = pending.find(name);
+    if (it == pending.end()) return;
+    if (skillId >= bySkill.size()) bySkill.resize(skillId + 1);
+    for (const auto& weak : it->second) {
+        auto state = weak.lock();
+        if (!state) continue;
+        std::lock_guard<std::mutex> stateLock(state->mutex);
+        auto pendingIt = std::find(state->pendingSkills.begin(), state->pendingSkills.end(), name);
+        if (pendingIt == state->pendingSkills.end()) continue;
+        state->pendingSkills.erase(pendingIt);
+        state->skillIds.insert(std::upper_bound(state->skillIds.begin(), state->skillIds.end(), skillId), skillId);
+        bySkill[skillId].push_back(weak);
+    }
+    pending.erase(it);
+}
+
+void RecommendationSubscriptions::publish(const std::vector<Job>& jobs, int jobId, const StringInterner& skillNames,
+                                          const StringInterner& locationNames) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const Job& job = jobs[jobId];
+
+    // Subscribers sharing at least one of the job's skills, exactly or through a similar skill
+    std::unordered_map<RecommendationState*, std::shared_ptr<RecommendationState>> matched;
+    for (uint32_t skillId : job.skillIds) {
+        if (!pending.empty()) promotePending(skillId, skillNames.str(skillId));
+        if (skillId >= bySkill.size()) continue;
+        Subscribers& subscribers = bySkill[skillId];
+        for (size_t i = 0; i < subscribers.size();) {
+            auto state = subscribers[i].lock();
+            if (!state) { // Session replaced or expired
+                subscribers[i] = std::move(subscribers.back());
+                subscribers.pop_back();
+                continue;
+            }
+            auto& entry = matched[state.get()];
+            if (!entry) entry = std::move(state);
+            ++i;
+        }
+    }
+    if (matched.empty()) return;
+
+    const std::string& jobLocation = locationNames.str(job.locationId);
+    for (const auto& entry : matched) {
+        RecommendationState& state = *entry.first;
+        std::lock_guard<std::mutex> stateLock(state.mutex);
+        if ((size_t)jobId < state.jobsSeen) continue; // Already matched from the skill matrix when subscribing
+        // The preferred location may only now have been interned by this job
+        if (state.where.locationId == StringInterner::NotFound && state.where.location == jobLocation) state.where.locationId = job.locationId;
+        if (acceptsJob(state, job)) appendMatch(state, job, jobId, skillOverlap(job.skillIds, state.skillIds, state.relatedSkills));
+        state.jobsSeen = jobId + 1;
+    }
+}
+
+size_t RecommendationSubscriptions::subscriptionCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t total = 0;
+    for (const auto& subscribers : bySkill) total += subscribers.size();
+    for (const auto& [name, subscribers] : pending) total += subscribers.size();
+    return total;
+}
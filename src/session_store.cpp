@@ -0,0 +1,123 @@
+#include "session_store.h"
+#include <algorithm>
+#include <functional>
+
+// Rough per-node cost of the list entry, map node and shared_ptr control block
+static constexpr size_t EntryOverhead = sizeof(Candidate) + 160;
+
+size_t sessionBytes(const std::string& sessionId, const Candidate& candidate) {
+    size_t bytes = EntryOverhead + 2 * sessionId.capacity(); // Key is held by both the list and the map
+    bytes += candidate.name.capacity() + candidate.preferredLocation.capacity();
+    bytes += candidate.skills.capacity() * sizeof(std::string);
+    for (const auto& skill : candidate.skills) bytes += skill.capacity();
+    return bytes;
+}
+
+SessionStore::SessionStore(size_t maxBytes, std::chrono::seconds idleTtl, size_t shardCount)
+    : maxBytes(maxBytes), idleTtl(idleTtl) {
+    for (size_t i = 0; i < std::max<size_t>(1, shardCount); ++i) {
+        shards.push_back(std::make_unique<Shard>());
+    }
+}
+
+void SessionStore::remove(Shard& shard, std::list<Entry>::iterator it) {
+    totalBytes -= it->bytes;
+    shard.map.erase(it->sessionId);
+    shard.lru.erase(it);
+}
+
+void SessionStore::expire(Shard& shard, Clock::time_point now) {
+    while (!shard.lru.empty() && now - shard.lru.back().lastAccess > idleTtl) {
+        remove(shard, std::prev(shard.lru.end()));
+        expirations++;
+    }
+}
+
+void SessionStore::sweepNext(Clock::time_point now) {
+    Shard& shard = *shards[sweepCursor++ % shards.size()];
+    if (!shard.mutex.try_lock()) return; // Busy; someone is already expiring it
+    expire(shard, now);
+    shard.mutex.unlock();
+}
+
+void SessionStore::put(const std::string& sessionId, Candidate candidate, size_t derivedBytes) {
+    size_t bytes = sessionBytes(sessionId, candidate) + derivedBytes;
+    auto stored = std::make_shared<const Candidate>(std::move(candidate));
+    Shard& shard = shardFor(sessionId);
+    Clock::time_point now = Clock::now();
+    sweepNext(now);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    expire(shard, now);
+
+    auto it = shard.map.find(sessionId);
+    if (it != shard.map.end()) {
+        totalBytes -= it->second->bytes;
+        it->second->candidate = std::move(stored);
+        it->second->lastAccess = now;
+        it->second->bytes = bytes;
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    } else {
+        shard.lru.push_front({sessionId, std::move(stored), now, bytes});
+        shard.map[sessionId] = shard.lru.begin();
+    }
+    totalBytes += bytes;
+    enforceLimit(shard, true);
+}
+
+void SessionStore::enforceLimit(Shard& held, bool keepNewest) {
+    while (totalBytes > maxBytes) {
+        // Oldest LRU tail among the held shard and every other shard free right now; waiting for a
+        // busy shard while holding one could deadlock, and its owner enforces the limit itself
+        Shard* victim = held.lru.size() > (keepNewest ? 1 : 0) ? &held : nullptr;
+        std::unique_lock<std::mutex> victimLock;
+        for (auto& shard : shards) {
+            if (shard.get() == &held) continue;
+            std::unique_lock<std::mutex> lock(shard->mutex, std::try_to_lock);
+            if (!lock || shard->lru.empty()) continue;
+            if (victim && victim->lru.back().lastAccess <= shard->lru.back().lastAccess) continue;
+            victim = shard.get();
+            victimLock = std::move(lock);
+        }
+        if (!victim) return;
+        remove(*victim, std::prev(victim->lru.end()));
+        evictions++;
+    }
+}
+
+void SessionStore::resize(const std::string& sessionId, const RecommendationState* recommendations, size_t derivedBytes) {
+    Shard& shard = shardFor(sessionId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.map.find(sessionId);
+    if (it == shard.map.end() || it->second->candidate->recommendations.get() != recommendations) return;
+    size_t bytes = sessionBytes(sessionId, *it->second->candidate) + derivedBytes;
+    totalBytes += bytes - it->second->bytes; // Unsigned wrap-around nets out
+    it->second->bytes = bytes;
+    // Growth on ingest can push an idle session over the limit, and then it may be the one evicted
+    enforceLimit(shard, false);
+}
+
+std::shared_ptr<const Candidate> SessionStore::get(const std::string& sessionId) {
+    Shard& shard = shardFor(sessionId);
+    Clock::time_point now = Clock::now();
+    sweepNext(now);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    expire(shard, now);
+
+    auto it = shard.map.find(sessionId);
+    if (it == shard.map.end()) return nullptr;
+    it->second->lastAccess = now;
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    return it->second->candidate;
+}
+
+SessionStore::Stats SessionStore::stats() const {
+    Stats s{};
+    for (const auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        s.sessions += shard->map.size();
+    }
+    s.bytes = totalBytes;
+    s.expirations = expirations;
+    s.evictions = evictions;
+    return s;
+}
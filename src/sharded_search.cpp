@@ -0,0 +1,99 @@
+#include "sharded_search.h"
+#include "tracing.h"
+#include <algorithm>
+#include <future>
+#include <queue>
+
+// Ranking order: higher score first, lower job id first among equal scores
+static bool better(const ScorePair& a, const ScorePair& b) {
+    return a.first != b.first ? a.first > b.first : a.second < b.second;
+}
+
+ShardedSearch::ShardedSearch(size_t shardCount)
+    : shards(std::max<size_t>(1, shardCount)), pool(std::max<size_t>(1, shardCount) - 1) {}
+
+void ShardedSearch::addJob(int jobId, const Job& job) {
+    Shard& shard = shards[jobId % shards.size()];
+    shard.index.addJob(shard.jobIds.size(), job);
+    shard.jobIds.push_back(jobId);
+    jobCount++;
+}
+
+size_t ShardedSearch::trigramCount() const {
+    size_t total = 0;
+    for (const auto& shard : shards) total += shard.index.trigramCount();
+    return total;
+}
+
+SearchResult ShardedSearch::searchShard(const Shard& shard, const std::vector<Job>& jobs, const std::vector<std::string>& terms,
+                                        size_t K, const Scorer& score, bool collectMatched) {
+    SearchResult result;
+    std::vector<int> localIds;
+    {
+        TRACE_SPAN("search.postings");
+        for (const auto& term : terms) {
+            std::vector<int> ids = shard.index.candidates(term, &result.postingsTouched);
+            localIds.insert(localIds.end(), ids.begin(), ids.end());
+        }
+        if (terms.size() > 1) {
+            std::sort(localIds.begin(), localIds.end());
+            localIds.erase(std::unique(localIds.begin(), localIds.end()), localIds.end());
+        }
+    }
+
+    TRACE_SPAN("search.score_shard");
+    result.scored = localIds.size();
+    // Heap whose top is the worst of the current K
+    std::priority_queue<ScorePair, std::vector<ScorePair>, decltype(&better)> topK(&better);
+    for (int localId : localIds) {
+        int jobId = shard.jobIds[localId];
+        int s = score(jobs[jobId]);
+        if (s > 0) {
+            if (collectMatched) result.matched.push_back(jobId);
+            if (topK.size() < K) {
+                topK.push({s, jobId});
+            } else if (better({s, jobId}, topK.top())) {
+                topK.pop();
+                topK.push({s, jobId});
+            }
+        }
+    }
+    while (!topK.empty()) {
+        result.top.push_back(topK.top());
+        topK.pop();
+    }
+    return result;
+}
+
+SearchResult ShardedSearch::search(const std::vector<Job>& jobs, const std::vector<std::string>& terms, size_t K,
+                                   const Scorer& score, bool collectMatched) const {
+    std::vector<SearchResult> perShard(shards.size());
+    if (jobCount < ParallelThreshold || pool.size() == 0) {
+        for (size_t i = 0; i < shards.size(); ++i) {
+            perShard[i] = searchShard(shards[i], jobs, terms, K, score, collectMatched);
+        }
+    } else {
+        std::vector<std::future<SearchResult>> pending;
+        for (size_t i = 1; i < shards.size(); ++i) {
+            pending.push_back(pool.submit([&, i]() { return searchShard(shards[i], jobs, terms, K, score, collectMatched); }));
+        }
+        perShard[0] = searchShard(shards[0], jobs, terms, K, score, collectMatched);
+        for (size_t i = 1; i < shards.size(); ++i) {
+            perShard[i] = pending[i - 1].get();
+        }
+    }
+
+    // Every shard kept its own best K under the same order, so the global best K are among them
+    TRACE_SPAN("search.merge");
+    SearchResult merged;
+    for (auto& shardResult : perShard) {
+        merged.top.insert(merged.top.end(), shardResult.top.begin(), shardResult.top.end());
+        merged.matched.insert(merged.matched.end(), shardResult.matched.begin(), shardResult.matched.end());
+        merged.postingsTouched += shardResult.postingsTouched;
+        merged.scored += shardResult.scored;
+    }
+    size_t n = std::min(K, merged.top.size());
+    std::partial_sort(merged.top.begin(), merged.top.begin() + n, merged.top.end(), better);
+    merged.top.resize(n);
+    return merged;
+}
@@ -0,0 +1,176 @@
+#include "skill_embeddings.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+void SkillEmbeddings::addJob(const std::vector<uint32_t>& skillIds) {
+    if (!skillIds.empty() && skillIds.back() >= jobsWithSkill.size()) {
+        jobsWithSkill.resize(skillIds.back() + 1, 0);
+        cooccurrences.resize(skillIds.back() + 1);
+    }
+    for (size_t i = 0; i < skillIds.size(); ++i) {
+        jobsWithSkill[skillIds[i]]++;
+        for (size_t j = i + 1; j < skillIds.size(); ++j) {
+            cooccurrences[skillIds[i]][skillIds[j]]++;
+            cooccurrences[skillIds[j]][skillIds[i]]++;
+        }
+    }
+    jobCount++;
+}
+
+bool SkillEmbeddings::rebuildDue() const {
+    return jobCount >= std::max<size_t>(64, builtAt + builtAt / 4);
+}
+
+SkillEmbeddings::Snapshot SkillEmbeddings::snapshot() const {
+    Snapshot snapshot;
+    snapshot.jobCount = jobCount;
+    snapshot.skills = jobsWithSkill.size();
+    snapshot.basis = basis;
+    for (size_t a = 0; a < snapshot.skills; ++a) {
+        if (jobsWithSkill[a] >= MinJobs) {
+            for (const auto& [b, together] : cooccurrences[a]) {
+                if (jobsWithSkill[b] < MinJobs) continue;
+                double pmi = std::log((double)together * jobCount / ((double)jobsWithSkill[a] * jobsWithSkill[b]));
+                if (pmi <= 0) continue;
+                snapshot.columns.push_back(b);
+                snapshot.values.push_back(pmi);
+            }
+        }
+        snapshot.offsets.push_back(snapshot.columns.size());
+    }
+    return snapshot;
+}
+
+SkillEmbeddings::Build SkillEmbeddings::build(Snapshot snapshot) {
+    size_t skills = snapshot.skills;
+    const auto& offsets = snapshot.offsets;
+    const auto& columns = snapshot.columns;
+    const auto& values = snapshot.values;
+    auto multiply = [&](const std::vector<float>& in, std::vector<float>& out) { // out = M * in, both skills x Dim
+        out.assign(skills * Dim, 0.0f);
+        for (size_t a = 0; a < skills; ++a) {
+            float* row = &out[a * Dim];
+            for (size_t k = offsets[a]; k < offsets[a + 1]; ++k) {
+                const float* other = &in[columns[k] * Dim];
+                for (size_t d = 0; d < Dim; ++d) row[d] += values[k] * other[d];
+            }
+        }
+    };
+
+    // Subspace iteration converges on the top-Dim eigenvectors. Starting from the previous
+    // build's basis (random rows for new skills) keeps successive builds nearly aligned, so
+    // vectors derived from an older build stay comparable with the new ones.
+    Build next;
+    next.jobCount = snapshot.jobCount;
+    std::vector<float>& basis = next.basis;
+    basis.swap(snapshot.basis);
+    std::mt19937 rng(42 + basis.size());
+    std::normal_distribution<float> normal;
+    std::vector<float> product;
+    size_t seeded = basis.size();
+    basis.resize(skills * Dim);
+    for (size_t i = seeded; i < basis.size(); ++i) basis[i] = normal(rng);
+    for (int iteration = 0; iteration < 4; ++iteration) {
+        multiply(basis, product);
+        // Modified Gram-Schmidt over the Dim columns
+        for (size_t d = 0; d < Dim; ++d) {
+            for (size_t e = 0; e < d; ++e) {
+                double projection = 0;
+                for (size_t a = 0; a < skills; ++a) projection += product[a * Dim + d] * product[a * Dim + e];
+                for (size_t a = 0; a < skills; ++a) product[a * Dim + d] -= projection * product[a * Dim + e];
+            }
+            double norm = 0;
+            for (size_t a = 0; a < skills; ++a) norm += product[a * Dim + d] * product[a * Dim + d];
+            norm = std::sqrt(norm);
+            for (size_t a = 0; a < skills; ++a) product[a * Dim + d] = norm > 1e-9 ? product[a * Dim + d] / norm : 0.0f;
+        }
+        basis.swap(product);
+    }
+
+    // Each skill's PMI row in that basis, unit length
+    std::vector<float>& vectors = next.vectors;
+    std::vector<uint8_t>& present = next.present;
+    multiply(basis, vectors);
+    present.assign(skills, 0);
+    for (size_t a = 0; a < skills; ++a) {
+        float* row = &vectors[a * Dim];
+        float norm = std::sqrt(dotProduct(row, row, Dim));
+        if (norm < 1e-6f) continue;
+        for (size_t d = 0; d < Dim; ++d) row[d] /= norm;
+        present[a] = 1;
+    }
+    return next;
+}
+
+void SkillEmbeddings::install(Build next) {
+    builtAt = next.jobCount;
+    builds++;
+    basis = std::move(next.basis);
+    vectors = std::move(next.vectors);
+    present = std::move(next.present);
+}
+
+const float* SkillEmbeddings::vector(uint32_t skillId) const {
+    return skillId < present.size() && present[skillId] ? &vectors[skillId * Dim] : nullptr;
+}
+
+float SkillEmbeddings::similarity(uint32_t a, uint32_t b) const {
+    const float* va = vector(a);
+    const float* vb = vector(b);
+    return va && vb ? dotProduct(va, vb, Dim) : 0.0f;
+}
+
+std::vector<std::pair<uint32_t, float>> SkillEmbeddings::nearest(uint32_t skillId, size_t limit, float minSimilarity) const {
+    std::vector<std::pair<uint32_t, float>> best;
+    const float* v = vector(skillId);
+    if (!v) return best;
+    for (uint32_t other = 0; other < present.size(); ++other) {
+        if (other == skillId || !present[other]) continue;
+        float similarity = dotProduct(v, &vectors[other * Dim], Dim);
+        if (similarity >= minSimilarity) best.push_back({other, similarity});
+    }
+    size_t keep = std::min(best.size(), limit);
+    std::partial_sort(best.begin(), best.begin() + keep, best.end(), [](const auto& x, const auto& y) {
+        return x.second != y.second ? x.second > y.second : x.first < y.first;
+    });
+    best.resize(keep);
+    return best;
+}
+
+std::vector<std::pair<uint32_t, float>> SkillEmbeddings::related(const std::vector<uint32_t>& skillIds) const {
+    std::vector<std::pair<uint32_t, float>> found;
+    for (uint32_t skillId : skillIds) {
+        size_t kept = 0;
+        for (const auto& [other, similarity] : nearest(skillId, MaxRelatedPerSkill + skillIds.size())) {
+            if (kept == MaxRelatedPerSkill) break;
+            if (std::binary_search(skillIds.begin(), skillIds.end(), other)) continue;
+            found.push_back({other, similarity});
+            kept++;
+        }
+    }
+    // One entry per related skill, with the best similarity to any of the profile's skills
+    std::sort(found.begin(), found.end(), [](const auto& x, const auto& y) { return x.first != y.first ? x.first < y.first : x.second > y.second; });
+    found.erase(std::unique(found.begin(), found.end(), [](const auto& x, const auto& y) { return x.first == y.first; }), found.end());
+    return found;
+}
+
+SkillOverlap skillOverlap(const std::vector<uint32_t>& jobSkills, const std::vector<uint32_t>& skillIds,
+                          const std::vector<std::pair<uint32_t, float>>& related) {
+    SkillOverlap overlap;
+    auto exact = skillIds.begin();
+    auto similar = related.begin();
+    for (uint32_t skillId : jobSkills) { // All three lists ascend
+        while (exact != skillIds.end() && *exact < skillId) ++exact;
+        if (exact != skillIds.end() && *exact == skillId) {
+            overlap.exact++;
+            overlap.score += 1;
+            continue;
+        }
+        while (similar != related.end() && similar->first < skillId) ++similar;
+        if (similar != related.end() && similar->first == skillId) {
+            overlap.similar++;
+            overlap.score += similar->second;
+        }
+    }
+    return overlap;
+}
@@ -0,0 +1,99 @@
+#include "slow_query_log.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <iostream>
+
+using json = nlohmann::ordered_json; // Keeps phases in execution order
+
+static uint64_t microsBetween(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(to - from).count();
+}
+
+QueryPlan::QueryPlan(const char* route) : route(route), started(std::chrono::steady_clock::now()), lastMark(started) {}
+
+void QueryPlan::endPhase(const char* name) {
+    auto now = std::chrono::steady_clock::now();
+    if (phaseCount < MaxPhases) phases[phaseCount++] = {name, microsBetween(lastMark, now)};
+    lastMark = now;
+}
+
+uint64_t QueryPlan::finish() {
+    totalMicros = microsBetween(started, std::chrono::steady_clock::now());
+    return totalMicros;
+}
+
+SlowQueryLog::SlowQueryLog(uint64_t thresholdMicros, const std::string& path, size_t queueCapacity)
+    : thresholdMicros(thresholdMicros), out(&std::cerr), queue(queueCapacity) {
+    if (!path.empty()) {
+        file.open(path, std::ios::app);
+        if (file) {
+            out = &file;
+        } else {
+            std::cerr << "Cannot open slow query log " << path << ", logging to stderr\n";
+        }
+    }
+    writer = std::thread(&SlowQueryLog::writerLoop, this);
+}
+
+SlowQueryLog::~SlowQueryLog() {
+    stopping = true;
+    writer.join();
+}
+
+void SlowQueryLog::submit(QueryPlan plan) {
+    if (!queue.push(std::move(plan))) droppedCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::string SlowQueryLog::recentJson() const {
+    std::lock_guard<std::mutex> lock(recentMutex);
+    std::string result = "[";
+    for (size_t i = 0; i < recent.size(); ++i) {
+        if (i) result += ',';
+        result += recent[i];
+    }
+    return result + "]";
+}
+
+void SlowQueryLog::writerLoop() {
+    QueryPlan plan;
+    auto idle = std::chrono::milliseconds(1);
+    for (;;) {
+        // Checked before popping so everything queued before shutdown is still written
+        bool finalPass = stopping.load();
+        bool wrote = false;
+        while (queue.pop(plan)) {
+            // Nothing may escape this thread: an uncaught exception here would terminate the server
+            try {
+                json entry;
+                entry["route"] = plan.route;
+                entry["query"] = plan.query;
+                entry["totalMicros"] = plan.totalMicros;
+                entry["candidateSkills"] = plan.candidateSkills;
+                entry["postingsTouched"] = plan.postingsTouched;
+                entry["jobsScored"] = plan.jobsScored;
+                entry["results"] = plan.results;
+                entry["phases"] = json::object();
+                for (size_t i = 0; i < plan.phaseCount; ++i) {
+                    entry["phases"][plan.phases[i].name] = plan.phases[i].micros;
+                }
+                // Queries are raw client input; invalid UTF-8 is replaced rather than thrown on
+                std::string line = entry.dump(-1, ' ', false, json::error_handler_t::replace);
+                *out << line << '\n';
+                {
+                    std::lock_guard<std::mutex> lock(recentMutex);
+                    recent.push_back(std::move(line));
+                    if (recent.size() > RecentLimit) recent.pop_front();
+                }
+                loggedCount.fetch_add(1, std::memory_order_relaxed);
+                wrote = true;
+            } catch (const std::exception& e) {
+                std::cerr << "Slow query log: dropped an entry for " << plan.route << ": " << e.what() << '\n';
+            }
+        }
+        if (wrote) out->flush();
+        if (finalPass) return;
+        // Back off while idle; slow queries are rare, so polling costs next to nothing
+        idle = wrote ? std::chrono::milliseconds(1) : std::min(idle * 2, std::chrono::milliseconds(50));
+        std::this_thread::sleep_for(idle);
+    }
+}
@@ -0,0 +1,121 @@
+#include "sparse_scoring.h"
+#include <algorithm>
+
+void SkillMatrix::addJob(const std::vector<uint32_t>& skillIds) {
+    int jobId = jobCount();
+    rowSkills.insert(rowSkills.end(), skillIds.begin(), skillIds.end());
+    rowOffsets.push_back(rowSkills.size());
+    for (uint32_t skillId : skillIds) {
+        if (skillId >= deltaColumns.size()) deltaColumns.resize(skillId + 1);
+        deltaColumns[skillId].push_back(jobId);
+    }
+    deltaNonZeros += skillIds.size();
+    // Rebuilding costs O(nonzeros), so wait until the delta is a quarter of the frozen part
+    if (deltaNonZeros > std::max<size_t>(65536, colJobs.size() / 4)) compact();
+}
+
+void SkillMatrix::compact() {
+    size_t columns = std::max(colOffsets.size() - 1, deltaColumns.size());
+    std::vector<uint32_t> offsets(columns + 1, 0);
+    std::vector<int> merged;
+    merged.reserve(colJobs.size() + deltaNonZeros);
+    for (size_t s = 0; s < columns; ++s) {
+        if (s + 1 < colOffsets.size()) merged.insert(merged.end(), colJobs.begin() + colOffsets[s], colJobs.begin() + colOffsets[s + 1]);
+        if (s < deltaColumns.size()) merged.insert(merged.end(), deltaColumns[s].begin(), deltaColumns[s].end());
+        offsets[s + 1] = merged.size();
+    }
+    colOffsets.swap(offsets);
+    colJobs.swap(merged);
+    frozenJobs = jobCount();
+    deltaColumns.assign(deltaColumns.size(), {});
+    deltaNonZeros = 0;
+}
+
+namespace {
+
+// Remaining entries of one column (frozen segment, then delta segment) for one row's skill
+struct ColumnCursor {
+    const int* frozen;
+    const int* frozenEnd;
+    const int* delta;
+    const int* deltaEnd;
+    uint32_t weight;
+};
+
+} // namespace
+
+size_t SkillMatrix::multiply(const std::vector<std::vector<uint32_t>>& rows, size_t firstJob, const Emit& emit,
+                             const std::vector<std::vector<uint32_t>>* weights) const {
+    size_t total = jobCount();
+    if (firstJob >= total) return 0;
+    thread_local std::vector<uint32_t> accumulator;
+    thread_local std::vector<uint32_t> touched;
+    accumulator.assign(JobBlock, 0);
+    size_t visited = 0;
+
+    std::vector<ColumnCursor> cursors;
+    std::vector<size_t> cursorStart;
+    for (size_t rowBegin = 0; rowBegin < rows.size(); rowBegin += RowBlock) {
+        size_t rowEnd = std::min(rowBegin + RowBlock, rows.size());
+
+        // Position every (row, skill) cursor at firstJob once; tiles then only move them forward
+        cursors.clear();
+        cursorStart.assign(1, 0);
+        for (size_t r = rowBegin; r < rowEnd; ++r) {
+            for (size_t k = 0; k < rows[r].size(); ++k) {
+                uint32_t s = rows[r][k];
+                ColumnCursor c{nullptr, nullptr, nullptr, nullptr, weights ? (*weights)[r][k] : (uint32_t)1};
+                if (s + 1 < colOffsets.size()) {
+                    c.frozen = colJobs.data() + colOffsets[s];
+                    c.frozenEnd = colJobs.data() + colOffsets[s + 1];
+                    c.frozen = std::lower_bound(c.frozen, c.frozenEnd, (int)firstJob);
+                }
+                if (s < deltaColumns.size()) {
+                    c.delta = deltaColumns[s].data();
+                    c.deltaEnd = c.delta + deltaColumns[s].size();
+                    c.delta = std::lower_bound(c.delta, c.deltaEnd, (int)firstJob);
+                }
+                cursors.push_back(c);
+            }
+            cursorStart.push_back(cursors.size());
+        }
+
+        for (size_t tileBegin = firstJob; tileBegin < total; tileBegin += JobBlock) {
+            int tileEnd = std::min(tileBegin + JobBlock, total);
+            for (size_t r = rowBegin; r < rowEnd; ++r) {
+                for (size_t i = cursorStart[r - rowBegin]; i < cursorStart[r - rowBegin + 1]; ++i) {
+                    ColumnCursor& c = cursors[i];
+                    for (; c.frozen != c.frozenEnd && *c.frozen < tileEnd; ++c.frozen) {
+                        uint32_t& sum = accumulator[*c.frozen - tileBegin];
+                        if (sum == 0) touched.push_back(*c.frozen - tileBegin);
+                        sum += c.weight;
+                        ++visited;
+                    }
+                    for (; c.delta != c.deltaEnd && *c.delta < tileEnd; ++c.delta) {
+                        uint32_t& sum = accumulator[*c.delta - tileBegin];
+                        if (sum == 0) touched.push_back(*c.delta - tileBegin);
+                        sum += c.weight;
+                        ++visited;
+                    }
+                }
+                // Dense tiles are cheaper to sweep than to sort
+                if (touched.size() * 16 > JobBlock) {
+                    for (size_t k = 0; k < JobBlock; ++k) {
+                        if (accumulator[k]) {
+                            emit(r, tileBegin + k, accumulator[k]);
+                            accumulator[k] = 0;
+                        }
+                    }
+                } else {
+                    std::sort(touched.begin(), touched.end());
+                    for (uint32_t k : touched) {
+                        emit(r, tileBegin + k, accumulator[k]);
+                        accumulator[k] = 0;
+                    }
+                }
+                touched.clear();
+            }
+        }
+    }
+    return visited;
+}
@@ -0,0 +1,107 @@
+#include "static_assets.h"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sys/stat.h>
+
+namespace {
+
+std::string contentTypeFor(const std::string& extension) {
+    static const std::unordered_map<std::string, std::string> types = {
+        {".html", "text/html; charset=utf-8"}, {".css", "text/css; charset=utf-8"},
+        {".js", "application/javascript; charset=utf-8"}, {".json", "application/json"},
+        {".svg", "image/svg+xml"}, {".txt", "text/plain; charset=utf-8"},
+        {".png", "image/png"}, {".jpg", "image/jpeg"}, {".ico", "image/x-icon"}};
+    auto it = types.find(extension);
+    return it == types.end() ? "application/octet-stream" : it->second;
+}
+
+// FNV-1a; only needs to change when the content does
+uint64_t contentHash(std::string_view data) {
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : data) hash = (hash ^ c) * 1099511628211ull;
+    return hash;
+}
+
+// Keeps a compressed form only if it saves at least a tenth of the bytes
+std::string precompress(const std::string& body, ContentEncoding encoding) {
+    std::string compressed = compress(body, encoding, 9);
+    return compressed.size() < body.size() - body.size() / 10 ? compressed : std::string();
+}
+
+} // namespace
+
+const std::string& StaticAsset::bodyFor(ContentEncoding& encoding) const {
+    if (encoding == ContentEncoding::Gzip && !gzip.empty()) return gzip;
+    if (encoding == ContentEncoding::Deflate && !deflate.empty()) return deflate;
+    encoding = ContentEncoding::Identity;
+    return body;
+}
+
+size_t StaticAssets::load(const std::string& dir) {
+    namespace fs = std::filesystem;
+    std::error_code error;
+    for (fs::recursive_directory_iterator it(dir, error), end; !error && it != end; it.increment(error)) {
+        if (!it->is_regular_file()) continue;
+        std::ifstream file(it->path(), std::ios::binary);
+        struct stat info;
+        if (!file || stat(it->path().c_str(), &info) != 0) continue;
+
+        StaticAsset asset;
+        asset.body.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        asset.contentType = contentTypeFor(it->path().extension().string());
+        asset.gzip = precompress(asset.body, ContentEncoding::Gzip);
+        asset.deflate = precompress(asset.body, ContentEncoding::Deflate);
+        char etag[24];
+        snprintf(etag, sizeof(etag), "W/\"%016llx\"", (unsigned long long)contentHash(asset.body));
+        asset.etag = etag;
+        asset.modified = info.st_mtime;
+        asset.lastModified = httpDate(info.st_mtime);
+        assets[fs::relative(it->path(), dir).generic_string()] = std::move(asset);
+    }
+    return assets.size();
+}
+
+const StaticAsset* StaticAssets::find(const std::string& path) const {
+    auto it = assets.find(path);
+    return it == assets.end() ? nullptr : &it->second;
+}
+
+bool etagMatches(std::string_view ifNoneMatch, std::string_view etag) {
+    if (etag.substr(0, 2) == "W/") etag.remove_prefix(2);
+    while (!ifNoneMatch.empty()) {
+        size_t comma = ifNoneMatch.find(',');
+        std::string_view tag = ifNoneMatch.substr(0, comma);
+        ifNoneMatch = comma == std::string_view::npos ? std::string_view() : ifNoneMatch.substr(comma + 1);
+        size_t begin = tag.find_first_not_of(" \t");
+        if (begin == std::string_view::npos) continue;
+        tag = tag.substr(begin, tag.find_last_not_of(" \t") - begin + 1);
+        if (tag == "*") return true;
+        if (tag.substr(0, 2) == "W/") tag.remove_prefix(2);
+        if (tag == etag) return true;
+    }
+    return false;
+}
+
+bool notModified(const StaticAsset& asset, std::string_view ifNoneMatch, std::string_view ifModifiedSince) {
+    // If-Modified-Since is ignored when If-None-Match is present
+    if (!ifNoneMatch.empty()) return etagMatches(ifNoneMatch, asset.etag);
+    if (ifModifiedSince.empty()) return false;
+    std::time_t since = parseHttpDate(ifModifiedSince);
+    return since != -1 && asset.modified <= since;
+}
+
+std::string httpDate(std::time_t time) {
+    std::tm tm;
+    gmtime_r(&time, &tm);
+    char buffer[40];
+    return std::string(buffer, strftime(buffer, sizeof(buffer), "%a, %d %b %Y %H:%M:%S GMT", &tm));
+}
+
+std::time_t parseHttpDate(std::string_view date) {
+    std::tm tm{};
+    std::string text(date);
+    const char* end = strptime(text.c_str(), "%a, %d %b %Y %H:%M:%S GMT", &tm);
+    return end ? timegm(&tm) : -1;
+}
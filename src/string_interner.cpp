@@ -0,0 +1,15 @@
+#include "string_interner.h"
+
+uint32_t StringInterner::intern(std::string_view s) {
+    auto it = ids.find(s);
+    if (it != ids.end()) return it->second;
+    uint32_t id = strings.size();
+    strings.emplace_back(s);
+    ids.emplace(strings.back(), id);
+    return id;
+}
+
+uint32_t StringInterner::find(std::string_view s) const {
+    auto it = ids.find(s);
+    return it == ids.end() ? NotFound : it->second;
+}
@@ -0,0 +1,32 @@
+#include "thread_pool.h"
+
+ThreadPool::ThreadPool(size_t threadCount) {
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    ready.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            ready.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (tasks.empty()) return; // Stopping and drained
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
@@ -0,0 +1,92 @@
+#include "tracing.h"
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+struct TraceEvent {
+    const char* name;
+    uint64_t startNs;
+    uint64_t durationNs;
+};
+
+// One per thread. The owning thread is the only writer; the mutex is only ever
+// contended while a dump or clear is copying this buffer.
+struct TraceBuffer {
+    std::mutex mutex;
+    std::vector<TraceEvent> events;
+    size_t next = 0;
+    bool wrapped = false;
+    uint32_t threadId;
+
+    explicit TraceBuffer(uint32_t threadId) : events(TraceBufferCapacity), threadId(threadId) {}
+};
+
+std::mutex registryMutex;
+std::vector<std::shared_ptr<TraceBuffer>> buffers;
+
+const std::chrono::steady_clock::time_point processStart = std::chrono::steady_clock::now();
+
+TraceBuffer& localBuffer() {
+    thread_local std::shared_ptr<TraceBuffer> buffer = [] {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        buffers.push_back(std::make_shared<TraceBuffer>(buffers.size() + 1));
+        return buffers.back();
+    }();
+    return *buffer;
+}
+
+} // namespace
+
+uint64_t traceNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - processStart).count();
+}
+
+void recordTraceEvent(const char* name, uint64_t startNs, uint64_t durationNs) {
+    TraceBuffer& buffer = localBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.events[buffer.next] = {name, startNs, durationNs};
+    if (++buffer.next == buffer.events.size()) {
+        buffer.next = 0;
+        buffer.wrapped = true;
+    }
+}
+
+std::string dumpChromeTrace() {
+    std::vector<std::shared_ptr<TraceBuffer>> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        snapshot = buffers;
+    }
+
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(3); // Microseconds with ns resolution
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (const auto& buffer : snapshot) {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        size_t count = buffer->wrapped ? buffer->events.size() : buffer->next;
+        size_t begin = buffer->wrapped ? buffer->next : 0; // Oldest surviving event
+        for (size_t i = 0; i < count; ++i) {
+            const TraceEvent& event = buffer->events[(begin + i) % buffer->events.size()];
+            out << (first ? "" : ",") << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                << buffer->threadId << ",\"ts\":" << event.startNs / 1000.0 << ",\"dur\":" << event.durationNs / 1000.0 << "}";
+            first = false;
+        }
+    }
+    out << "]}";
+    return out.str();
+}
+
+void clearTraceEvents() {
+    std::lock_guard<std::mutex> registryLock(registryMutex);
+    for (const auto& buffer : buffers) {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        buffer->next = 0;
+        buffer->wrapped = false;
+    }
+}
@@ -0,0 +1,176 @@
+#include "wire_format.h"
+#include <cfloat>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+
+namespace {
+
+void appendBigEndian(std::string& out, uint64_t value, int bytes) {
+    for (int shift = (bytes - 1) * 8; shift >= 0; shift -= 8) out += char(value >> shift);
+}
+
+// The float32 bits of value if converting loses nothing
+bool exactFloat(double value, uint32_t& bits) {
+    if (!(std::fabs(value) <= FLT_MAX)) return false; // Out of range, or NaN
+    float narrow = (float)value;
+    if ((double)narrow != value) return false;
+    std::memcpy(&bits, &narrow, sizeof(bits));
+    return true;
+}
+
+uint64_t doubleBits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+} // namespace
+
+WireFormat negotiateFormat(std::string_view accept) {
+    WireFormat best = WireFormat::Json;
+    double bestQ = 0;
+    while (!accept.empty()) {
+        size_t comma = accept.find(',');
+        std::string_view entry = accept.substr(0, comma);
+        accept = comma == std::string_view::npos ? std::string_view() : accept.substr(comma + 1);
+
+        size_t semicolon = entry.find(';');
+        std::string_view type = entry.substr(0, semicolon);
+        size_t begin = type.find_first_not_of(" \t");
+        if (begin == std::string_view::npos) continue;
+        type = type.substr(begin, type.find_last_not_of(" \t") - begin + 1);
+        double q = 1;
+        size_t qAt = semicolon == std::string_view::npos ? std::string_view::npos : entry.find("q=", semicolon);
+        if (qAt != std::string_view::npos) q = std::strtod(std::string(entry.substr(qAt + 2)).c_str(), nullptr);
+
+        auto is = [&](const char* name) {
+            return type.size() == std::strlen(name) && strncasecmp(type.data(), name, type.size()) == 0;
+        };
+        WireFormat format;
+        if (is("application/msgpack") || is("application/x-msgpack") || is("application/vnd.msgpack")) format = WireFormat::MsgPack;
+        else if (is("application/cbor")) format = WireFormat::Cbor;
+        else if (is("application/json") || is("application/*") || is("*/*")) format = WireFormat::Json;
+        else continue;
+        if (q > bestQ) {
+            best = format;
+            bestQ = q;
+        }
+    }
+    return best;
+}
+
+const char* formatName(WireFormat format) {
+    switch (format) {
+    case WireFormat::MsgPack: return "msgpack";
+    case WireFormat::Cbor: return "cbor";
+    default: return "json";
+    }
+}
+
+const char* contentTypeFor(WireFormat format) {
+    switch (format) {
+    case WireFormat::MsgPack: return "application/msgpack";
+    case WireFormat::Cbor: return "application/cbor";
+    default: return "application/json";
+    }
+}
+
+void MsgPackWriter::open(bool map) {
+    countValue();
+    containers.push_back({out.size(), 0, map});
+    out.append(5, '\0'); // Type byte and 32-bit size, until close() knows the size
+}
+
+void MsgPackWriter::close(uint8_t fix, uint8_t size16, uint8_t size32) {
+    Container container = containers.back();
+    containers.pop_back();
+    std::string size;
+    if (container.count < 16) {
+        size += char(fix | container.count);
+    } else if (container.count <= 0xffff) {
+        size += char(size16);
+        appendBigEndian(size, container.count, 2);
+    } else {
+        size += char(size32);
+        appendBigEndian(size, container.count, 4);
+    }
+    out.replace(container.offset, 5, size);
+}
+
+void MsgPackWriter::appendString(std::string_view value) {
+    size_t length = value.size();
+    if (length < 32) {
+        out += char(0xa0 | length);
+    } else if (length <= 0xff) {
+        out += char(0xd9);
+        appendBigEndian(out, length, 1);
+    } else if (length <= 0xffff) {
+        out += char(0xda);
+        appendBigEndian(out, length, 2);
+    } else {
+        out += char(0xdb);
+        appendBigEndian(out, length, 4);
+    }
+    out += value;
+}
+
+void MsgPackWriter::number(double value) {
+    countValue();
+    uint32_t bits;
+    if (exactFloat(value, bits)) {
+        out += char(0xca);
+        appendBigEndian(out, bits, 4);
+    } else {
+        out += char(0xcb);
+        appendBigEndian(out, doubleBits(value), 8);
+    }
+}
+
+void MsgPackWriter::integer(int64_t value) {
+    countValue();
+    if (value >= 0) {
+        if (value < 128) out += char(value);
+        else if (value <= 0xff) { out += char(0xcc); appendBigEndian(out, value, 1); }
+        else if (value <= 0xffff) { out += char(0xcd); appendBigEndian(out, value, 2); }
+        else if (value <= 0xffffffffll) { out += char(0xce); appendBigEndian(out, value, 4); }
+        else { out += char(0xcf); appendBigEndian(out, value, 8); }
+    } else {
+        if (value >= -32) out += char(value);
+        else if (value >= INT8_MIN) { out += char(0xd0); appendBigEndian(out, value, 1); }
+        else if (value >= INT16_MIN) { out += char(0xd1); appendBigEndian(out, value, 2); }
+        else if (value >= INT32_MIN) { out += char(0xd2); appendBigEndian(out, value, 4); }
+        else { out += char(0xd3); appendBigEndian(out, value, 8); }
+    }
+}
+
+void CborWriter::head(uint8_t major, uint64_t argument) {
+    uint8_t type = major << 5;
+    if (argument < 24) {
+        out += char(type | argument);
+    } else if (argument <= 0xff) {
+        out += char(type | 24);
+        appendBigEndian(out, argument, 1);
+    } else if (argument <= 0xffff) {
+        out += char(type | 25);
+        appendBigEndian(out, argument, 2);
+    } else if (argument <= 0xffffffffull) {
+        out += char(type | 26);
+        appendBigEndian(out, argument, 4);
+    } else {
+        out += char(type | 27);
+        appendBigEndian(out, argument, 8);
+    }
+}
+
+void CborWriter::number(double value) {
+    uint32_t bits;
+    if (exactFloat(value, bits)) {
+        out += char(0xfa);
+        appendBigEndian(out, bits, 4);
+    } else {
+        out += char(0xfb);
+        appendBigEndian(out, doubleBits(value), 8);
+    }
+}
@@ -0,0 +1,212 @@
+#include "workload.h"
+#include "job_portal.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+struct Role {
+    const char* title;
+    std::vector<const char*> coreSkills;
+    double baseSalary; // Median for a mid-level hire
+};
+
+const std::vector<Role>& roles() {
+    static const std::vector<Role> table = {
+        {"Software Engineer", {"Java", "Python", "Go", "SQL", "Git", "Docker"}, 90000},
+        {"Backend Developer", {"Java", "Spring", "Node.js", "PostgreSQL", "Redis", "Kafka"}, 85000},
+        {"Frontend Developer", {"JavaScript", "TypeScript", "React", "CSS", "HTML", "Redux"}, 80000},
+        {"Full Stack Developer", {"JavaScript", "React", "Node.js", "MongoDB", "TypeScript", "Express"}, 85000},
+        {"Data Analyst", {"SQL", "Excel", "Tableau", "Python", "Power BI", "Statistics"}, 60000},
+        {"Data Scientist", {"Python", "Machine Learning", "TensorFlow", "Pandas", "SQL", "Statistics"}, 100000},
+        {"Data Engineer", {"Spark", "Kafka", "Airflow", "Python", "SQL", "Scala"}, 95000},
+        {"DevOps Engineer", {"Kubernetes", "Docker", "Terraform", "AWS", "Linux", "Jenkins"}, 95000},
+        {"Cloud Architect", {"AWS", "Azure", "GCP", "Terraform", "Kubernetes", "Networking"}, 130000},
+        {"Machine Learning Engineer", {"Python", "PyTorch", "TensorFlow", "MLOps", "Kubernetes", "C++"}, 115000},
+        {"Mobile Developer", {"Kotlin", "Swift", "Android", "iOS", "Flutter", "React Native"}, 85000},
+        {"QA Engineer", {"Selenium", "Java", "Cypress", "Jira", "Python", "API Testing"}, 65000},
+        {"Security Engineer", {"Networking", "Linux", "Python", "SIEM", "Penetration Testing", "AWS"}, 110000},
+        {"Product Manager", {"Jira", "Roadmapping", "SQL", "Analytics", "Agile", "Communication"}, 105000},
+        {"Embedded Engineer", {"C", "C++", "RTOS", "Linux", "ARM", "Python"}, 90000},
+        {"Site Reliability Engineer", {"Kubernetes", "Go", "Prometheus", "Linux", "AWS", "Terraform"}, 110000},
+    };
+    return table;
+}
+
+// Ordered most to least popular; Zipf ranks index into this list
+const std::vector<const char*>& skillVocabulary() {
+    static const std::vector<const char*> skills = {
+        "Python", "Java", "JavaScript", "SQL", "AWS", "React", "Docker", "Kubernetes", "TypeScript", "Node.js",
+        "Git", "Linux", "Go", "C++", "Spring", "Excel", "Machine Learning", "PostgreSQL", "Terraform", "Azure",
+        "Kafka", "Spark", "MongoDB", "Redis", "GCP", "Tableau", "TensorFlow", "PyTorch", "C#", ".NET",
+        "Django", "Flask", "Angular", "Vue", "GraphQL", "Scala", "Rust", "Kotlin", "Swift", "Airflow",
+        "Pandas", "Power BI", "Jenkins", "Prometheus", "Elasticsearch", "Selenium", "Jira", "Agile", "HTML", "CSS",
+        "Statistics", "Hadoop", "Snowflake", "dbt", "Ruby", "Rails", "PHP", "Laravel", "Flutter", "React Native",
+        "Android", "iOS", "C", "RTOS", "ARM", "MLOps", "Cypress", "Express", "Redux", "Networking",
+        "SIEM", "Penetration Testing", "API Testing", "Analytics", "Roadmapping", "Communication", "Figma", "Haskell", "Elixir", "Perl"};
+    return skills;
+}
+
+const std::vector<const char*>& locationVocabulary() {
+    static const std::vector<const char*> locations = {
+        "Bangalore", "Remote", "Hyderabad", "Pune", "Mumbai", "Chennai", "Gurgaon", "Noida", "Delhi", "Kolkata",
+        "Ahmedabad", "Kochi", "Jaipur", "Chandigarh", "Indore", "Coimbatore", "Thiruvananthapuram", "Bhubaneswar",
+        "Mysore", "Nagpur", "Lucknow", "Vadodara", "Visakhapatnam", "Mangalore", "Goa", "Surat", "Bhopal", "Dehradun"};
+    return locations;
+}
+
+const char* levels[] = {"Junior", "", "Senior", "Lead", "Staff", "Principal"};
+const double levelWeights[] = {0.2, 0.3, 0.3, 0.1, 0.06, 0.04};
+const double levelSalary[] = {0.6, 1.0, 1.4, 1.7, 2.0, 2.4};
+
+const char* firstNames[] = {"Aarav", "Priya", "Rohan", "Ananya", "Vikram", "Sneha", "Arjun", "Kavya", "Rahul", "Meera",
+                            "Aditya", "Isha", "Karan", "Divya", "Siddharth", "Neha", "Alex", "Sam", "Jordan", "Taylor"};
+const char* lastNames[] = {"Sharma", "Iyer", "Reddy", "Patel", "Gupta", "Nair", "Singh", "Menon", "Rao", "Kumar",
+                           "Das", "Joshi", "Bose", "Kapoor", "Shah", "Pillai", "Smith", "Lee", "Garcia", "Chen"};
+
+} // namespace
+
+// --- ZipfDistribution ---
+
+ZipfDistribution::ZipfDistribution(size_t n, double s) {
+    cdf.reserve(n);
+    double total = 0;
+    for (size_t rank = 1; rank <= n; ++rank) {
+        total += 1.0 / std::pow((double)rank, s);
+        cdf.push_back(total);
+    }
+    for (auto& c : cdf) c /= total;
+}
+
+size_t ZipfDistribution::operator()(std::mt19937_64& rng) const {
+    double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+    size_t rank = std::lower_bound(cdf.begin(), cdf.end(), u) - cdf.begin();
+    return std::min(rank, cdf.size() - 1);
+}
+
+// --- WorkloadGenerator ---
+
+WorkloadGenerator::WorkloadGenerator(const WorkloadConfig& config)
+    : config(config), rng(config.seed),
+      skillPick(skillVocabulary().size(), config.skillSkew),
+      locationPick(locationVocabulary().size(), config.locationSkew),
+      companyPick(config.companies, config.companySkew),
+      rolePick(roles().size(), 0.8) {
+    static const char* prefixes[] = {"Infra", "Quantum", "Blue", "Nova", "Pixel", "Cloud", "Data", "Bright", "Tata",
+                                     "Apex", "Zen", "Core", "Swift", "Green", "Vertex", "Lumen", "Orbit", "Kite"};
+    static const char* suffixes[] = {"Labs", "Systems", "Technologies", "Solutions", "Software", "Networks",
+                                     "Analytics", "Digital", "Works", "Softech", "Infotech", "AI"};
+    for (size_t i = 0; i < config.companies; ++i) {
+        std::string name = std::string(prefixes[i % 18]) + " " + suffixes[(i / 18) % 12];
+        if (i >= 18 * 12) name += " " + std::to_string(i / (18 * 12) + 1);
+        companyNames.push_back(name);
+    }
+
+    // Searches draw from skills, role names/words and locations. Each list is already in
+    // popularity order, so interleaving them by rank keeps the head of the Zipf popular.
+    std::vector<std::string> roleTerms;
+    for (const auto& role : roles()) {
+        roleTerms.push_back(toLower(role.title));
+        for (const auto& word : tokenize(role.title)) roleTerms.push_back(word);
+    }
+    const auto& skills = skillVocabulary();
+    const auto& locations = locationVocabulary();
+    for (size_t rank = 0; rank < std::max({skills.size(), roleTerms.size(), locations.size()}); ++rank) {
+        for (std::string term : {rank < skills.size() ? toLower(skills[rank]) : std::string(),
+                                 rank < roleTerms.size() ? roleTerms[rank] : std::string(),
+                                 rank < locations.size() ? toLower(locations[rank]) : std::string()}) {
+            if (!term.empty() && std::find(searchVocabulary.begin(), searchVocabulary.end(), term) == searchVocabulary.end()) {
+                searchVocabulary.push_back(term);
+            }
+        }
+    }
+    searchPick = ZipfDistribution(searchVocabulary.size(), config.querySkew);
+}
+
+std::vector<std::string> WorkloadGenerator::pickSkills(size_t role, int count) {
+    const auto& core = roles()[role].coreSkills;
+    std::vector<std::string> skills;
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    std::uniform_int_distribution<size_t> corePick(0, core.size() - 1);
+    for (int attempts = 0; (int)skills.size() < count && attempts < count * 4; ++attempts) {
+        std::string skill = coin(rng) < 0.7 ? core[corePick(rng)] : skillVocabulary()[skillPick(rng)];
+        if (std::find(skills.begin(), skills.end(), skill) == skills.end()) skills.push_back(skill);
+    }
+    return skills;
+}
+
+Job WorkloadGenerator::nextJob() {
+    std::discrete_distribution<int> levelPick(std::begin(levelWeights), std::end(levelWeights));
+    std::uniform_int_distribution<int> skillCount(3, 7);
+    std::lognormal_distribution<double> salaryNoise(0.0, 0.25);
+
+    size_t role = rolePick(rng);
+    int level = levelPick(rng);
+    Job job;
+    job.title = std::string(levels[level]).empty() ? roles()[role].title : std::string(levels[level]) + " " + roles()[role].title;
+    job.company = companyNames[companyPick(rng)];
+    job.location = locationVocabulary()[locationPick(rng)];
+    job.skills = pickSkills(role, skillCount(rng));
+    job.salary = std::round(roles()[role].baseSalary * levelSalary[level] * salaryNoise(rng) / 100) * 100;
+    job.description = job.company + " is hiring a " + job.title + " in " + job.location + " to work with " +
+                      job.skills.front() + " and " + job.skills.back() + ".";
+    return job;
+}
+
+Candidate WorkloadGenerator::nextCandidate() {
+    std::uniform_int_distribution<int> skillCount(2, 6), namePick(0, 19);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    std::lognormal_distribution<double> salaryNoise(0.0, 0.3);
+
+    size_t role = rolePick(rng);
+    Candidate candidate;
+    candidate.name = std::string(firstNames[namePick(rng)]) + " " + lastNames[namePick(rng)];
+    candidate.skills = pickSkills(role, skillCount(rng));
+    candidate.preferredLocation = coin(rng) < 0.2 ? "" : locationVocabulary()[locationPick(rng)]; // Some are open to anywhere
+    candidate.expectedSalary = std::round(roles()[role].baseSalary * 0.8 * salaryNoise(rng) / 100) * 100;
+    candidate.isProfileSet = true;
+    return candidate;
+}
+
+std::string WorkloadGenerator::misspell(std::string word) {
+    if (word.size() < 4) return word;
+    std::uniform_int_distribution<size_t> pos(1, word.size() - 2);
+    std::uniform_int_distribution<int> kind(0, 2), letter('a', 'z');
+    size_t i = pos(rng);
+    switch (kind(rng)) {
+        case 0: word.erase(i, 1); break;                   // "javscript"
+        case 1: std::swap(word[i], word[i + 1]); break;    // "kuberentes"
+        default: word[i] = (char)letter(rng); break;
+    }
+    return word;
+}
+
+WorkloadQuery WorkloadGenerator::nextQuery(size_t candidateCount) {
+    // Mix: 60% search, 30% autocomplete, 10% recommendations (when there are candidates)
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    double kind = coin(rng);
+    if (kind < 0.1 && candidateCount > 0) {
+        if (sessionPick.size() != candidateCount) sessionPick = ZipfDistribution(candidateCount, 1.0);
+        return {"recommend", "session-" + std::to_string(sessionPick(rng))};
+    }
+    if (kind < 0.4) {
+        // Prefixes people type before picking a suggestion: mostly 1-4 characters
+        std::geometric_distribution<int> extra(0.45);
+        std::string title = roles()[rolePick(rng)].title;
+        size_t length = std::min(title.size(), (size_t)1 + extra(rng));
+        return {"autocomplete", title.substr(0, length)};
+    }
+    std::string query = searchVocabulary[searchPick(rng)];
+    if (coin(rng) < config.typoRate) query = misspell(query);
+    return {"search", query};
+}
+
+std::vector<Job> generateJobs(size_t n, unsigned long seed) {
+    WorkloadConfig config;
+    config.seed = seed;
+    WorkloadGenerator generator(config);
+    std::vector<Job> jobs;
+    jobs.reserve(n);
+    for (size_t i = 0; i < n; ++i) jobs.push_back(generator.nextJob());
+    return jobs;
+}
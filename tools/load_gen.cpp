@@ -0,0 +1,375 @@
+// HTTP load generator for the job portal server.
+//
+//   load_gen [--host H] [--port P] [--duration SECONDS] [--rate REQ_PER_SEC] [--connections N]
+//            [--mix search=60,autocomplete=25,recommend=10,post=3,profile=1,list=1]
+//            [--workload DIR] [--json FILE]
+//
+// Requests are issued open-loop: request i is due at start + i / rate no matter how
+// long earlier requests took. Latency is measured from that intended start, so time a
+// request spends queued behind a slow one is counted (coordinated omission correction);
+// service time from the actual send is reported alongside. --rate 0 runs closed-loop.
+// With --workload DIR (from workload_gen), queries come from queries.tsv, POST bodies
+// from jobs.ndjson and candidates.ndjson, and every candidate profile is posted first.
+#include "metrics.h"
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct Options {
+    std::string host = "127.0.0.1";
+    int port = 8080;
+    double duration = 10;
+    double rate = 1000;
+    int connections = 8;
+    std::string mix = "search=60,autocomplete=25,recommend=10,post=3,profile=1,list=1";
+    std::string workload;
+    std::string jsonOut;
+};
+
+struct Request {
+    std::string kind;
+    std::string method;
+    std::string target;
+    std::string body;
+};
+
+std::string urlEncode(const std::string& s) {
+    std::ostringstream out;
+    for (unsigned char c : s) {
+        if (std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') out << c;
+        else out << '%' << std::uppercase << std::hex << std::setw(2) << std::setfill('0') << (int)c << std::dec;
+    }
+    return out.str();
+}
+
+std::vector<std::string> readLines(const std::string& path) {
+    std::vector<std::string> lines;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty()) lines.push_back(line);
+    }
+    return lines;
+}
+
+// Requests for each kind, cycled through in order
+class RequestSource {
+private:
+    std::map<std::string, std::vector<Request>> byKind;
+    std::vector<std::string> kinds;
+    std::vector<double> cumulativeWeights;
+
+public:
+    RequestSource(const Options& options, const std::vector<std::string>& queries,
+                  const std::vector<std::string>& jobBodies, const std::vector<std::string>& profileBodies) {
+        for (const auto& line : queries) {
+            size_t tab = line.find('\t');
+            if (tab == std::string::npos) continue;
+            std::string kind = line.substr(0, tab), value = line.substr(tab + 1);
+            if (kind == "search") byKind["search"].push_back({kind, "GET", "/api/jobs/search?q=" + urlEncode(value), ""});
+            else if (kind == "autocomplete") byKind["autocomplete"].push_back({kind, "GET", "/api/autocomplete?prefix=" + urlEncode(value), ""});
+            else if (kind == "recommend") byKind["recommend"].push_back({kind, "GET", "/api/recommendations?sessionId=" + urlEncode(value), ""});
+        }
+        if (byKind["search"].empty()) {
+            for (const char* q : {"java", "python", "remote", "data analyst", "react"}) {
+                byKind["search"].push_back({"search", "GET", "/api/jobs/search?q=" + urlEncode(q), ""});
+            }
+        }
+        if (byKind["autocomplete"].empty()) {
+            for (const char* p : {"S", "Se", "Data", "D", "Front"}) {
+                byKind["autocomplete"].push_back({"autocomplete", "GET", "/api/autocomplete?prefix=" + urlEncode(p), ""});
+            }
+        }
+        if (byKind["recommend"].empty()) byKind["recommend"].push_back({"recommend", "GET", "/api/recommendations?sessionId=default", ""});
+        for (const auto& body : jobBodies) byKind["post"].push_back({"post", "POST", "/api/jobs", body});
+        if (byKind["post"].empty()) {
+            byKind["post"].push_back({"post", "POST", "/api/jobs",
+                                      R"({"title":"Load Test Engineer","company":"Load Gen","location":"Remote","salary":50000,"skills":["C++","Linux"]})"});
+        }
+        for (const auto& body : profileBodies) byKind["profile"].push_back({"profile", "POST", "/api/profile", body});
+        if (byKind["profile"].empty()) {
+            byKind["profile"].push_back({"profile", "POST", "/api/profile",
+                                         R"({"sessionId":"default","name":"Load Gen","skills":["C++","Linux"],"location":"","salary":0})"});
+        }
+        byKind["list"].push_back({"list", "GET", "/api/jobs", ""});
+
+        double total = 0;
+        std::istringstream mix(options.mix);
+        std::string entry;
+        while (std::getline(mix, entry, ',')) {
+            size_t eq = entry.find('=');
+            std::string kind = entry.substr(0, eq);
+            if (eq == std::string::npos || !byKind.count(kind)) {
+                throw std::runtime_error("unknown mix entry: " + entry);
+            }
+            kinds.push_back(kind);
+            total += std::stod(entry.substr(eq + 1));
+            cumulativeWeights.push_back(total);
+        }
+        if (kinds.empty() || total <= 0) throw std::runtime_error("empty request mix");
+    }
+
+    // The n-th request of the run; deterministic so runs are comparable. Safe to call from any thread.
+    const Request& at(uint64_t n) const {
+        std::mt19937_64 rng(n * 0x9E3779B97F4A7C15ull + 1);
+        double u = std::uniform_real_distribution<double>(0.0, cumulativeWeights.back())(rng);
+        size_t k = std::min(kinds.size() - 1, (size_t)(std::upper_bound(cumulativeWeights.begin(), cumulativeWeights.end(), u) -
+                                                       cumulativeWeights.begin()));
+        const auto& requests = byKind.at(kinds[k]);
+        return requests[(n / kinds.size()) % requests.size()];
+    }
+};
+
+// Blocking HTTP/1.1 keep-alive connection
+class Connection {
+private:
+    const Options& options;
+    int fd = -1;
+    std::string buffer;
+
+    bool connectToServer() {
+        addrinfo hints{}, *result = nullptr;
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+        if (getaddrinfo(options.host.c_str(), std::to_string(options.port).c_str(), &hints, &result) != 0) return false;
+        fd = socket(result->ai_family, result->ai_socktype, result->ai_protocol);
+        bool ok = fd >= 0 && connect(fd, result->ai_addr, result->ai_addrlen) == 0;
+        freeaddrinfo(result);
+        if (!ok) {
+            close();
+            return false;
+        }
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        return true;
+    }
+
+    void close() {
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+        buffer.clear();
+    }
+
+public:
+    explicit Connection(const Options& options) : options(options) {}
+    ~Connection() { close(); }
+
+    // Returns the HTTP status, or 0 on a transport error
+    int roundTrip(const Request& request, size_t& responseBytes) {
+        for (int attempt = 0; attempt < 2; ++attempt) {
+            if (fd < 0 && !connectToServer()) return 0;
+            std::string wire = request.method + " " + request.target + " HTTP/1.1\r\nHost: " + options.host +
+                               "\r\nConnection: keep-alive\r\n";
+            if (!request.body.empty()) {
+                wire += "Content-Type: application/json\r\nContent-Length: " + std::to_string(request.body.size()) + "\r\n";
+            }
+            wire += "\r\n" + request.body;
+            if (send(fd, wire.data(), wire.size(), MSG_NOSIGNAL) != (ssize_t)wire.size()) {
+                close();
+                continue; // Server closed an idle keep-alive connection; reconnect once
+            }
+            int status = readResponse(responseBytes);
+            if (status > 0) return status;
+            close();
+        }
+        return 0;
+    }
+
+private:
+    bool fill() {
+        char chunk[16384];
+        ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) return false;
+        buffer.append(chunk, n);
+        return true;
+    }
+
+    int readResponse(size_t& responseBytes) {
+        size_t headerEnd;
+        while ((headerEnd = buffer.find("\r\n\r\n")) == std::string::npos) {
+            if (!fill()) return 0;
+        }
+        int status = std::atoi(buffer.c_str() + buffer.find(' ') + 1);
+        size_t contentLength = 0;
+        std::string headers = buffer.substr(0, headerEnd);
+        for (auto& c : headers) c = std::tolower((unsigned char)c);
+        size_t pos = headers.find("content-length:");
+        if (pos != std::string::npos) contentLength = std::strtoull(headers.c_str() + pos + 15, nullptr, 10);
+        while (buffer.size() < headerEnd + 4 + contentLength) {
+            if (!fill()) return 0;
+        }
+        responseBytes = contentLength;
+        buffer.erase(0, headerEnd + 4 + contentLength);
+        return status;
+    }
+};
+
+struct ThreadResults {
+    LatencyHistogram corrected; // From intended start
+    LatencyHistogram service;   // From actual send
+    std::map<std::string, uint64_t> byKind;
+    uint64_t errors = 0;
+    uint64_t bytes = 0;
+    uint64_t maxCorrectedMicros = 0;
+};
+
+void usage() {
+    std::cerr << "usage: load_gen [--host H] [--port P] [--duration S] [--rate R] [--connections N] [--mix k=w,...]"
+                 " [--workload DIR] [--json FILE]\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            usage();
+            return 2;
+        }
+        std::string value = argv[++i];
+        if (arg == "--host") options.host = value;
+        else if (arg == "--port") options.port = std::stoi(value);
+        else if (arg == "--duration") options.duration = std::stod(value);
+        else if (arg == "--rate") options.rate = std::stod(value);
+        else if (arg == "--connections") options.connections = std::max(1, std::stoi(value));
+        else if (arg == "--mix") options.mix = value;
+        else if (arg == "--workload") options.workload = value;
+        else if (arg == "--json") options.jsonOut = value;
+        else {
+            usage();
+            return 2;
+        }
+    }
+
+    std::vector<std::string> queries, jobBodies, profileBodies;
+    if (!options.workload.empty()) {
+        queries = readLines(options.workload + "/queries.tsv");
+        jobBodies = readLines(options.workload + "/jobs.ndjson");
+        profileBodies = readLines(options.workload + "/candidates.ndjson");
+    }
+    std::unique_ptr<RequestSource> source;
+    try {
+        source = std::make_unique<RequestSource>(options, queries, jobBodies, profileBodies);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 2;
+    }
+
+    // Recommendations need profiles; post them all before the timed run
+    if (!profileBodies.empty()) {
+        Connection setup(options);
+        size_t bytes;
+        for (const auto& body : profileBodies) {
+            if (setup.roundTrip({"profile", "POST", "/api/profile", body}, bytes) == 0) {
+                std::cerr << "cannot reach " << options.host << ":" << options.port << "\n";
+                return 1;
+            }
+        }
+        std::cout << "Posted " << profileBodies.size() << " candidate profiles\n";
+    }
+
+    std::atomic<uint64_t> nextRequest{0};
+    std::vector<ThreadResults> results(options.connections);
+    auto start = Clock::now();
+    auto end = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.duration));
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < options.connections; ++t) {
+        threads.emplace_back([&, t]() {
+            Connection connection(options);
+            ThreadResults& mine = results[t];
+            while (true) {
+                uint64_t n = nextRequest++;
+                auto intended = Clock::now();
+                if (options.rate > 0) {
+                    intended = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(n / options.rate));
+                    if (intended >= end) break;
+                    std::this_thread::sleep_until(intended);
+                } else if (intended >= end) {
+                    break;
+                }
+
+                const Request& request = source->at(n);
+                auto sent = Clock::now();
+                size_t bytes = 0;
+                int status = connection.roundTrip(request, bytes);
+                auto done = Clock::now();
+
+                uint64_t correctedMicros = std::chrono::duration_cast<std::chrono::microseconds>(done - intended).count();
+                mine.corrected.record(correctedMicros);
+                mine.service.record(std::chrono::duration_cast<std::chrono::microseconds>(done - sent).count());
+                mine.maxCorrectedMicros = std::max(mine.maxCorrectedMicros, correctedMicros);
+                mine.byKind[request.kind]++;
+                mine.bytes += bytes;
+                if (status < 200 || status >= 400) mine.errors++;
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<uint64_t> corrected(LatencyHistogram::BucketCount), service(LatencyHistogram::BucketCount);
+    std::map<std::string, uint64_t> byKind;
+    uint64_t total = 0, errors = 0, bytes = 0, maxMicros = 0;
+    for (const auto& r : results) {
+        r.corrected.addTo(corrected);
+        r.service.addTo(service);
+        for (const auto& [kind, count] : r.byKind) {
+            byKind[kind] += count;
+            total += count;
+        }
+        errors += r.errors;
+        bytes += r.bytes;
+        maxMicros = std::max(maxMicros, r.maxCorrectedMicros);
+    }
+
+    auto ms = [](uint64_t micros) { return micros / 1000.0; };
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Requests: " << total << " in " << elapsed << " s (" << total / elapsed << " req/s, target "
+              << (options.rate > 0 ? std::to_string((int)options.rate) : std::string("closed-loop")) << "), errors: " << errors
+              << ", response bytes: " << bytes << "\n";
+    for (const auto& [kind, count] : byKind) std::cout << "  " << kind << ": " << count << "\n";
+    std::cout << "Latency (ms)        p50       p90       p99      p999       max\n";
+    std::cout << "  corrected " << std::setw(9) << ms(histogramQuantile(corrected, 0.5)) << " " << std::setw(9)
+              << ms(histogramQuantile(corrected, 0.9)) << " " << std::setw(9) << ms(histogramQuantile(corrected, 0.99)) << " "
+              << std::setw(9) << ms(histogramQuantile(corrected, 0.999)) << " " << std::setw(9) << ms(maxMicros) << "\n";
+    std::cout << "  service   " << std::setw(9) << ms(histogramQuantile(service, 0.5)) << " " << std::setw(9)
+              << ms(histogramQuantile(service, 0.9)) << " " << std::setw(9) << ms(histogramQuantile(service, 0.99)) << " "
+              << std::setw(9) << ms(histogramQuantile(service, 0.999)) << "\n";
+
+    if (!options.jsonOut.empty()) {
+        std::ofstream out(options.jsonOut);
+        out << std::fixed << std::setprecision(3) << "{\"requests\":" << total << ",\"seconds\":" << elapsed
+            << ",\"throughput\":" << total / elapsed << ",\"targetRate\":" << options.rate << ",\"errors\":" << errors
+            << ",\"latencyMs\":{\"p50\":" << ms(histogramQuantile(corrected, 0.5)) << ",\"p99\":" << ms(histogramQuantile(corrected, 0.99))
+            << ",\"p999\":" << ms(histogramQuantile(corrected, 0.999)) << ",\"max\":" << ms(maxMicros) << "}"
+            << ",\"serviceMs\":{\"p50\":" << ms(histogramQuantile(service, 0.5)) << ",\"p99\":" << ms(histogramQuantile(service, 0.99))
+            << ",\"p999\":" << ms(histogramQuantile(service, 0.999)) << "}}\n";
+    }
+    return errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,111 @@
+// Synthetic workload generator.
+//
+//   workload_gen [--jobs N] [--candidates N] [--queries N] [--seed S] [--out DIR] [--cli]
+//
+// Writes to DIR (default "workload"):
+//   jobs.ndjson        one job per line, ready for POST /api/jobs/bulk
+//   candidates.ndjson  one /api/profile body per line, sessionIds "session-0".."session-N-1"
+//   queries.tsv        "<search|autocomplete|recommend>\t<value>" per line, Zipf-skewed
+//   cli_session.txt    (--cli) keystrokes for job_portal_cli: posts every job, sets the
+//                      first candidate's profile, replays the queries, then exits
+#include "workload.h"
+#include <nlohmann/json.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sys/stat.h>
+#include <vector>
+
+using json = nlohmann::json;
+
+static void usage() {
+    std::cerr << "usage: workload_gen [--jobs N] [--candidates N] [--queries N] [--seed S] [--out DIR] [--cli]\n";
+}
+
+static std::string joinSkills(const std::vector<std::string>& skills) {
+    std::string line;
+    for (size_t i = 0; i < skills.size(); ++i) line += (i ? ", " : "") + skills[i];
+    return line;
+}
+
+int main(int argc, char** argv) {
+    size_t jobCount = 10000, candidateCount = 1000, queryCount = 100000;
+    std::string outDir = "workload";
+    bool cli = false;
+    WorkloadConfig config;
+
+    for (int i = 1; i < argc; ++i) {
+        auto value = [&]() -> const char* {
+            if (i + 1 >= argc) {
+                usage();
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+        if (!std::strcmp(argv[i], "--jobs")) jobCount = std::strtoull(value(), nullptr, 10);
+        else if (!std::strcmp(argv[i], "--candidates")) candidateCount = std::strtoull(value(), nullptr, 10);
+        else if (!std::strcmp(argv[i], "--queries")) queryCount = std::strtoull(value(), nullptr, 10);
+        else if (!std::strcmp(argv[i], "--seed")) config.seed = std::strtoull(value(), nullptr, 10);
+        else if (!std::strcmp(argv[i], "--out")) outDir = value();
+        else if (!std::strcmp(argv[i], "--cli")) cli = true;
+        else {
+            usage();
+            return 2;
+        }
+    }
+
+    mkdir(outDir.c_str(), 0755);
+    WorkloadGenerator generator(config);
+
+    std::ofstream jobsOut(outDir + "/jobs.ndjson");
+    std::vector<Job> jobs;
+    for (size_t i = 0; i < jobCount; ++i) {
+        Job job = generator.nextJob();
+        jobsOut << json{{"title", job.title}, {"company", job.company}, {"location", job.location},
+                        {"salary", job.salary}, {"skills", job.skills}, {"description", job.description}}.dump() << "\n";
+        if (cli) jobs.push_back(std::move(job));
+    }
+
+    std::ofstream candidatesOut(outDir + "/candidates.ndjson");
+    std::vector<Candidate> candidates;
+    for (size_t i = 0; i < candidateCount; ++i) {
+        Candidate candidate = generator.nextCandidate();
+        candidatesOut << json{{"sessionId", "session-" + std::to_string(i)}, {"name", candidate.name},
+                              {"skills", candidate.skills}, {"location", candidate.preferredLocation},
+                              {"salary", candidate.expectedSalary}}.dump() << "\n";
+        if (cli && candidates.empty()) candidates.push_back(candidate);
+    }
+
+    std::ofstream queriesOut(outDir + "/queries.tsv");
+    std::vector<WorkloadQuery> queries;
+    for (size_t i = 0; i < queryCount; ++i) {
+        WorkloadQuery query = generator.nextQuery(candidateCount);
+        queriesOut << query.kind << "\t" << query.value << "\n";
+        if (cli) queries.push_back(std::move(query));
+    }
+
+    if (cli) {
+        // Menu input for src/main.cpp: 1 post, 2 profile, 3 search, 4 recommend, 5 autocomplete, 6 exit
+        std::ofstream session(outDir + "/cli_session.txt");
+        for (const auto& job : jobs) {
+            session << "1\n" << job.title << "\n" << job.company << "\n" << job.location << "\n"
+                    << joinSkills(job.skills) << "\n" << job.salary << "\n";
+        }
+        if (!candidates.empty()) {
+            const Candidate& c = candidates.front();
+            session << "2\n" << c.name << "\n" << joinSkills(c.skills) << "\n" << c.preferredLocation << "\n"
+                    << c.expectedSalary << "\n";
+        }
+        for (const auto& query : queries) {
+            if (query.kind == "search") session << "3\n" << query.value << "\n";
+            else if (query.kind == "autocomplete") session << "5\n" << query.value << "\n";
+            else if (!candidates.empty()) session << "4\n";
+        }
+        session << "6\n";
+    }
+
+    std::cout << "Wrote " << jobCount << " jobs, " << candidateCount << " candidates and " << queryCount
+              << " queries to " << outDir << "/\n";
+    return 0;
+}